@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    This file contains the FIFO that carries the output of the plugin from the audio thread to the spectrum analyzer.
+
+    The audio thread writes the mono mix of every block (The mean of the channels, in float whatever the precision
+    of the host) and the analyzer of the editor reads every sample that is ready on each vblank, so the FFT runs on
+    the message thread. Like MeterFifo it is a juce::AbstractFifo over a fixed buffer: writing never blocks or
+    allocates, and the samples that do not fit are dropped while the editor is not reading.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class AnalyzerFifo
+{
+public:
+    static constexpr int capacity = 16384; //Samples (About a third of a second at 48 kHz, the analyzer reads it about 60 times per second)
+
+    template <typename SampleType>
+    void push(const juce::dsp::AudioBlock<SampleType>& block) noexcept //Audio thread, writes the mono mix of a block
+    {
+        const auto numChannels = block.getNumChannels();
+        const auto numSamples = juce::jmin((int) block.getNumSamples(), fifo.getFreeSpace());
+
+        if (numChannels == 0 || numSamples == 0)
+            return;
+
+        const auto scale = (SampleType) 1 / (SampleType) numChannels;
+        const auto scope = fifo.write(numSamples);
+
+        const auto mix = [&](int start, int size, int offset) //Channel by channel, so every channel is read in order
+        {
+            auto* destination = samples.data() + start;
+
+            const auto* first = block.getChannelPointer(0) + offset;
+
+            for (int i = 0; i < size; ++i)
+                destination[i] = (float) (first[i] * scale);
+
+            for (size_t channel = 1; channel < numChannels; ++channel)
+            {
+                const auto* source = block.getChannelPointer(channel) + offset;
+
+                for (int i = 0; i < size; ++i)
+                    destination[i] += (float) (source[i] * scale);
+            }
+        };
+
+        if (scope.blockSize1 > 0) mix(scope.startIndex1, scope.blockSize1, 0);
+        if (scope.blockSize2 > 0) mix(scope.startIndex2, scope.blockSize2, scope.blockSize1);
+    }
+
+    template <typename Function>
+    int pop(Function&& receiveSamples) noexcept //Message thread, passes the samples that are ready in one or two runs and returns how many there were
+    {
+        const auto scope = fifo.read(fifo.getNumReady());
+
+        if (scope.blockSize1 > 0) receiveSamples(samples.data() + scope.startIndex1, scope.blockSize1);
+        if (scope.blockSize2 > 0) receiveSamples(samples.data() + scope.startIndex2, scope.blockSize2);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+private:
+    juce::AbstractFifo fifo { capacity };
+    std::array<float, capacity> samples {};
+};
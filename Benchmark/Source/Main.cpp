@@ -0,0 +1,1475 @@
+/*
+  ==============================================================================
+
+    This file contains the benchmark of the plugin.
+
+    The processBlock suite times MultiPluginAudioProcessor::processBlock for every mode of the plugin, for block
+    sizes from 16 to 4096 samples, mono and stereo (Or the --channels layouts), with static and with constantly
+    moving parameters. The results are printed as ns/sample and as the percentage of realtime at 44.1/48/96/192 kHz,
+    and can be written as CSV or JSON. A JSON file from an older build can be given with --compare to find
+    regressions between releases.
+
+    The filterEngine suite compares the SIMD state variable filter (Kernels compiled for every response type) with the
+    generic juce::dsp::StateVariableTPTFilter path that branches on the type for every sample, both for speed and for
+    the difference between their outputs. It also times the cascades of 2 to 4 sections, fused in one loop, against the
+    same sections run as separate filters one after the other, and the ladder filter against the 24 dB/oct cascade.
+    Last, it times an LFO sweep of the cutoff with tan() and the coefficients computed for every sample against the
+    control rates of the modulation, which ramp the coefficients between the steps, and checks that the ramped sweeps
+    stay close to the exact one.
+
+    The multiband suite compares the cost of the 3 and 4 band compressor with the broadband compressor on the same
+    channels, to check that the bands share the work instead of costing one compressor each.
+
+    The detector suite times the compressor with the peak and the RMS detector, unlinked, partly and fully linked and
+    with a soft knee, to check that linking is cheaper than compressing every channel on its own. It also times the
+    shortest and the longest RMS window, which cost the same with the running sum, and the compressor keyed by a
+    sidechain (Read in place, so it should cost the same as keyed by itself) with and without the highpass of the key.
+
+    The fastMath suite times every approximation of FastMath against the std:: function (Or juce::Decibels) it
+    replaces, in float and in double, on blocks of values. It also checks the relative error of each one over its
+    whole domain against the bound in FastMath::maximumError(), and fails when one is out of it.
+
+    The oversampling suite times the filter mode with every oversampling factor and type, and prints the latency
+    that each of them reports to the host.
+
+    The precision suite times every mode with the float and with the double processBlock, the SIMD processes fit half
+    as many channels in a register in double so they are expected to be up to twice as slow.
+
+    The silence suite times every mode with noise and with silent input once the tail has passed, when the processor
+    only clears the blocks.
+
+    The state suite times getStateInformation and setStateInformation over 1000 instances with different settings,
+    against the XML of the value tree, and checks that a restored instance saves exactly the state it was given.
+
+    The realtime suite runs every mode in float and double through moving parameters, jumps of every parameter,
+    program changes, resets and silent stretches, and fails when the realtime checker caught an allocation, a lock or a
+    blocking call on the audio thread. It needs a build with MULTIPLUGIN_RT_CHECK=1.
+
+    The editor suite times the painting of 50 open editors: whole frames with the images of the shared look and feel
+    cached and rendered every time, and the repaint of a dragged knob with the old juce::GlowEffect and with the
+    cached glow.
+
+    Usage: Multi-Plugin-Benchmark [--suite <name>] [--seconds <s>] [--repetitions <n>] [--csv <file>] [--json <file>]
+                                  [--compare <baseline.json>] [--tolerance <percent>]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/SIMDStateVariableFilter.h"
+#include "../../Source/SIMDLadderFilter.h"
+#include "../../Source/FilterModulation.h"
+#include "../../Source/FastMath.h"
+#include "../../Source/MultiChannelCompressor.h"
+#include "../../Source/MultibandCompressor.h"
+#include "../../Source/MultiPluginLookAndFeel.h"
+#include "../../Source/RealtimeCheck.h"
+
+//==============================================================================
+namespace
+{
+    const int blockSizes[] = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    const double sampleRates[] = { 44100.0, 48000.0, 96000.0, 192000.0 }; //Rates used for the percentage of realtime
+    constexpr double preparedSampleRate = 48000.0; //Rate the processor is prepared with (The cost per sample does not depend on it)
+
+    struct Options //Everything read from the command line
+    {
+        juce::String suite = "processBlock";
+        double secondsPerCase = 0.1; //Measured time of every repetition
+        int repetitions = 5; //The median of the repetitions is reported
+        juce::File csvFile, jsonFile, baselineFile;
+        double tolerancePercent = 10.0; //Slowdown allowed by --compare before a case counts as a regression
+        juce::Array<int> channelCounts { 1, 2 }; //Layouts of the processBlock suite (e.g. --channels 1,2,6,12,16 for surround and ambisonics)
+    };
+
+    struct Result //One measured case
+    {
+        juce::String suite, name;
+        int blockSize = 0, numChannels = 0;
+        bool movingParameters = false;
+        double nsPerUnit = 0.0; //Time per sample frame (All channels together) unless the suite times something else
+        juce::String unit = "sample"; //Or value (fastMath), instance (state) and frame (editor)
+
+        juce::String getKey() const { return suite + "/" + name + "/" + juce::String(blockSize) + "/" + juce::String(numChannels) + (movingParameters ? "/moving" : "/static"); }
+        bool isPerSample() const { return unit == "sample"; } //Only the times per sample frame have a percentage of realtime
+        double getRealtimePercent(double sampleRate) const { return nsPerUnit * sampleRate * 1.0e-7; } //(ns * samples/s) / 1e9 * 100
+    };
+
+    void print(const juce::String& text)
+    {
+        std::cout << text << std::endl;
+    }
+
+    //==============================================================================
+    void setParameter(MultiPluginAudioProcessor& processor, const char* parameterID, float value) //Same path as host automation
+    {
+        auto* parameter = processor.parameters.getParameter(parameterID);
+        jassert(parameter != nullptr);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    bool configure(MultiPluginAudioProcessor& processor, int numChannels, int blockSize,
+                   juce::AudioProcessor::ProcessingPrecision precision = juce::AudioProcessor::singlePrecision)
+    {
+        processor.releaseResources();
+        processor.setProcessingPrecision(precision); //Has to be set before prepareToPlay, like the hosts do
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        layout.outputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+
+        if (! processor.setBusesLayout(layout))
+            return false;
+
+        processor.setRateAndBufferSizeDetails(preparedSampleRate, blockSize);
+        processor.prepareToPlay(preparedSampleRate, blockSize);
+        return true;
+    }
+
+    double median(juce::Array<double> values)
+    {
+        values.sort();
+        return values[values.size() / 2];
+    }
+
+    //Feeds white noise to processBuffer block by block and returns the median time per sample frame in ns. Only processBuffer is timed,
+    //the copy of the noise and beforeBlock (Used for the parameter changes that the host does before the callback) are not.
+    //The sample type is float unless it is given (timeBlocks<double>), it is not deduced from the lambda.
+    template <typename SampleType = float>
+    double timeBlocks(int numChannels, int blockSize, const Options& options,
+                      const std::function<void(int blockIndex)>& beforeBlock,
+                      const typename std::common_type<std::function<void(juce::AudioBuffer<SampleType>&)>>::type& processBuffer)
+    {
+        constexpr int noiseLength = 1 << 16;
+        juce::AudioBuffer<SampleType> noise(numChannels, noiseLength);
+        juce::Random random(1234);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < noiseLength; ++i)
+                noise.setSample(channel, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+
+        juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+        int blockIndex = 0, noisePosition = 0;
+
+        auto runFor = [&](double seconds)
+        {
+            juce::int64 ticks = 0, samples = 0;
+            const auto ticksToRun = juce::Time::secondsToHighResolutionTicks(seconds);
+
+            while (ticks < ticksToRun)
+            {
+                if (noisePosition + blockSize > noiseLength)
+                    noisePosition = 0;
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    buffer.copyFrom(channel, 0, noise, channel, noisePosition, blockSize);
+
+                noisePosition += blockSize;
+
+                if (beforeBlock != nullptr)
+                    beforeBlock(blockIndex);
+
+                ++blockIndex;
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                processBuffer(buffer);
+                ticks += juce::Time::getHighResolutionTicks() - start;
+                samples += blockSize;
+            }
+
+            return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / (double) samples;
+        };
+
+        runFor(options.secondsPerCase * 0.2); //Warm up (Caches, branch predictors and the first coefficient updates)
+
+        juce::Array<double> measurements;
+
+        for (int i = 0; i < options.repetitions; ++i)
+            measurements.add(runFor(options.secondsPerCase));
+
+        return median(measurements);
+    }
+
+    template <typename SampleType = float>
+    double timeProcessBlock(juce::AudioProcessor& processor, int numChannels, int blockSize, const Options& options,
+                            const std::function<void(int blockIndex)>& moveParameters)
+    {
+        juce::MidiBuffer midiMessages;
+        return timeBlocks<SampleType>(numChannels, blockSize, options, moveParameters,
+                                      [&](juce::AudioBuffer<SampleType>& buffer) { processor.processBlock(buffer, midiMessages); });
+    }
+
+    //Runs run once per repetition and returns the median time per unit in ns, for the suites that do not time audio blocks
+    double timeRepetitions(const Options& options, int numUnitsPerRepetition, const std::function<void(int repetition)>& run)
+    {
+        juce::Array<double> times;
+
+        for (int repetition = 0; repetition < options.repetitions; ++repetition)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            run(repetition);
+            times.add(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9 / numUnitsPerRepetition);
+        }
+
+        return median(times);
+    }
+
+    void printResult(const Result& result, const juce::String& extra = {})
+    {
+        if (! result.isPerSample()) //Values, instances and frames are printed in us when they are long
+        {
+            const auto inMicroseconds = result.nsPerUnit >= 10000.0;
+            print(result.name.paddedRight(' ', 32) + juce::String(inMicroseconds ? result.nsPerUnit / 1000.0 : result.nsPerUnit, 2).paddedLeft(' ', 10)
+                  + (inMicroseconds ? " us/" : " ns/") + result.unit + extra);
+            return;
+        }
+
+        print(result.name.paddedRight(' ', 24) + juce::String(result.blockSize).paddedLeft(' ', 6) + juce::String(result.numChannels).paddedLeft(' ', 4)
+              + (result.movingParameters ? "  moving" : "  static") + juce::String(result.nsPerUnit, 2).paddedLeft(' ', 12) + " ns/sample"
+              + juce::String(result.getRealtimePercent(48000.0), 4).paddedLeft(' ', 10) + " % @ 48 kHz" + extra);
+    }
+
+    void addResult(juce::Array<Result>& results, const Result& result, const juce::String& extra = {})
+    {
+        results.add(result);
+        printResult(result, extra);
+    }
+
+    //==============================================================================
+    struct ModeCase //One mode of the plugin with its static settings and the parameters it moves
+    {
+        juce::String name;
+        std::function<void(MultiPluginAudioProcessor&)> setUp;
+        std::function<void(MultiPluginAudioProcessor&, int blockIndex)> move;
+    };
+
+    juce::Array<ModeCase> getModeCases()
+    {
+        juce::Array<ModeCase> cases;
+
+        auto moveFilter = [](MultiPluginAudioProcessor& processor, int blockIndex) //Sweeps the frequency and the resonance every block
+        {
+            const auto phase = (float) std::sin(blockIndex * 0.05);
+            setParameter(processor, ParameterIDs::filterFrequency, std::round(1000.0f * std::pow(2.0f, 3.0f * phase)));
+            setParameter(processor, ParameterIDs::filterResonance, 3.0f + 2.0f * phase);
+        };
+
+        const char* filterNames[] = { "filter/lowpass", "filter/bandpass", "filter/highpass" };
+
+        for (int filterType = FilterTypes::lowPass; filterType <= FilterTypes::highPass; ++filterType)
+        {
+            auto setUpFilter = [filterType](MultiPluginAudioProcessor& processor)
+            {
+                setParameter(processor, ParameterIDs::pluginType, (float) PluginTypes::filter);
+                setParameter(processor, ParameterIDs::filterType, (float) filterType);
+                setParameter(processor, ParameterIDs::filterFrequency, 1000.0f);
+                setParameter(processor, ParameterIDs::filterResonance, 2.0f);
+            };
+
+            cases.add(ModeCase { filterNames[filterType], setUpFilter, moveFilter });
+        }
+
+        auto setUpSteepFilter = [](MultiPluginAudioProcessor& processor) //4 sections in a cascade
+        {
+            setParameter(processor, ParameterIDs::pluginType, (float) PluginTypes::filter);
+            setParameter(processor, ParameterIDs::filterSlope, (float) FilterSlopes::dB48);
+            setParameter(processor, ParameterIDs::filterFrequency, 1000.0f);
+            setParameter(processor, ParameterIDs::filterResonance, 2.0f);
+        };
+
+        cases.add(ModeCase { "filter/lowpass48", setUpSteepFilter, moveFilter });
+
+        auto setUpLadder = [](MultiPluginAudioProcessor& processor)
+        {
+            setParameter(processor, ParameterIDs::pluginType, (float) PluginTypes::filter);
+            setParameter(processor, ParameterIDs::filterTopology, (float) FilterTopologies::ladder);
+            setParameter(processor, ParameterIDs::filterFrequency, 1000.0f);
+            setParameter(processor, ParameterIDs::filterResonance, 2.0f);
+        };
+
+        cases.add(ModeCase { "filter/ladder", setUpLadder, moveFilter });
+
+        auto setUpModulated = [](MultiPluginAudioProcessor& processor) //LFO and envelope follower on the cutoff and the resonance
+        {
+            setParameter(processor, ParameterIDs::pluginType, (float) PluginTypes::filter);
+            setParameter(processor, ParameterIDs::filterSlope, (float) FilterSlopes::dB24);
+            setParameter(processor, ParameterIDs::filterFrequency, 1000.0f);
+            setParameter(processor, ParameterIDs::filterResonance, 2.0f);
+            setParameter(processor, ParameterIDs::filterLfoRate, 2.0f);
+            setParameter(processor, ParameterIDs::filterLfoCutoff, 2.0f);
+            setParameter(processor, ParameterIDs::filterLfoResonance, 1.0f);
+            setParameter(processor, ParameterIDs::filterEnvelopeCutoff, 1.0f);
+        };
+
+        cases.add(ModeCase { "filter/modulated", setUpModulated, moveFilter });
+
+        auto setUpCompressor = [](MultiPluginAudioProcessor& processor)
+        {
+            setParameter(processor, ParameterIDs::pluginType, (float) PluginTypes::compressor);
+            setParameter(processor, ParameterIDs::compressorThreshold, -20.0f);
+            setParameter(processor, ParameterIDs::compressorRatio, 4.0f);
+            setParameter(processor, ParameterIDs::compressorAttack, 5.0f);
+            setParameter(processor, ParameterIDs::compressorRelease, 100.0f);
+            setParameter(processor, ParameterIDs::gainGain, 3.3f);
+        };
+
+        auto moveCompressor = [](MultiPluginAudioProcessor& processor, int blockIndex) //Moves every compressor and gain parameter every block
+        {
+            const auto phase = (float) std::sin(blockIndex * 0.05);
+            setParameter(processor, ParameterIDs::compressorThreshold, std::round(-15.0f + 10.0f * phase));
+            setParameter(processor, ParameterIDs::compressorRatio, std::round(5.0f + 3.0f * phase));
+            setParameter(processor, ParameterIDs::compressorAttack, 10.0f + 9.0f * phase);
+            setParameter(processor, ParameterIDs::compressorRelease, 200.0f + 150.0f * phase);
+            setParameter(processor, ParameterIDs::gainGain, 1.1f * std::round(5.0f + 4.0f * phase));
+        };
+
+        cases.add(ModeCase { "compressor", setUpCompressor, moveCompressor });
+
+        auto setUpLookahead = [setUpCompressor](MultiPluginAudioProcessor& processor) //Compressor with the audio going through the delay line
+        {
+            setUpCompressor(processor);
+            setParameter(processor, ParameterIDs::compressorLookahead, 5.0f);
+        };
+
+        cases.add(ModeCase { "compressor/lookahead", setUpLookahead, moveCompressor });
+
+        auto setUpRms = [setUpCompressor](MultiPluginAudioProcessor& processor) //Linked RMS compressor with a soft knee
+        {
+            setUpCompressor(processor);
+            setParameter(processor, ParameterIDs::compressorDetector, (float) CompressorDetectors::rms);
+            setParameter(processor, ParameterIDs::compressorLink, 1.0f);
+            setParameter(processor, ParameterIDs::compressorKnee, 6.0f);
+        };
+
+        cases.add(ModeCase { "compressor/rms", setUpRms, moveCompressor });
+
+        for (auto bands : { CompressorBands::three, CompressorBands::four })
+        {
+            auto setUpMultiband = [setUpCompressor, bands](MultiPluginAudioProcessor& processor)
+            {
+                setUpCompressor(processor);
+                setParameter(processor, ParameterIDs::compressorMultiband, 1.0f);
+                setParameter(processor, ParameterIDs::compressorBands, (float) bands);
+                setParameter(processor, ParameterIDs::compressorBand1Threshold, -20.0f);
+                setParameter(processor, ParameterIDs::compressorBand2Threshold, -15.0f);
+                setParameter(processor, ParameterIDs::compressorBand3Threshold, -20.0f);
+                setParameter(processor, ParameterIDs::compressorBand4Threshold, -25.0f);
+            };
+
+            cases.add(ModeCase { bands == CompressorBands::four ? "compressor/multiband4" : "compressor/multiband3", setUpMultiband, moveCompressor });
+        }
+
+        auto setUpChain = [setUpCompressor](MultiPluginAudioProcessor& processor) //Filter, compressor and gain in one instance
+        {
+            setUpCompressor(processor);
+            setParameter(processor, ParameterIDs::pluginType, (float) PluginTypes::chain);
+            setParameter(processor, ParameterIDs::filterFrequency, 1000.0f);
+            setParameter(processor, ParameterIDs::filterResonance, 2.0f);
+        };
+
+        auto moveChain = [moveFilter, moveCompressor](MultiPluginAudioProcessor& processor, int blockIndex)
+        {
+            moveFilter(processor, blockIndex);
+            moveCompressor(processor, blockIndex);
+        };
+
+        cases.add(ModeCase { "chain", setUpChain, moveChain });
+
+        auto movePrograms = [](MultiPluginAudioProcessor& processor, int blockIndex) //Switches to the next preset every block (Static runs the Init preset)
+        {
+            processor.setCurrentProgram(blockIndex % processor.getNumPrograms());
+        };
+
+        cases.add(ModeCase { "programs", [](MultiPluginAudioProcessor&) {}, movePrograms });
+
+        return cases;
+    }
+
+    void runProcessBlockSuite(const Options& options, juce::Array<Result>& results)
+    {
+        for (auto& modeCase : getModeCases())
+        {
+            for (auto numChannels : options.channelCounts)
+            {
+                for (auto blockSize : blockSizes)
+                {
+                    for (auto movingParameters : { false, true })
+                    {
+                        MultiPluginAudioProcessor processor; //New processor for every case, so no state is carried over
+
+                        if (! configure(processor, numChannels, blockSize))
+                        {
+                            print("Skipping " + modeCase.name + ": " + juce::String(numChannels) + " channels are not supported");
+                            continue;
+                        }
+
+                        modeCase.setUp(processor);
+
+                        Result result { "processBlock", modeCase.name, blockSize, numChannels, movingParameters };
+                        result.nsPerUnit = timeProcessBlock(processor, numChannels, blockSize, options,
+                                                            movingParameters ? std::function<void(int)>([&](int blockIndex) { modeCase.move(processor, blockIndex); })
+                                                                             : std::function<void(int)>());
+                        results.add(result);
+                        printResult(result);
+                    }
+                }
+            }
+        }
+    }
+
+    void runPrecisionSuite(const Options& options, juce::Array<Result>& results) //Every mode in float and in double
+    {
+        for (auto& modeCase : getModeCases())
+        {
+            if (modeCase.name == "programs") //Only moves the parameters, its static case is the default filter
+                continue;
+
+            for (auto numChannels : options.channelCounts)
+            {
+                for (auto blockSize : { 64, 512 })
+                {
+                    MultiPluginAudioProcessor floatProcessor, doubleProcessor;
+
+                    if (! configure(floatProcessor, numChannels, blockSize) || ! configure(doubleProcessor, numChannels, blockSize, juce::AudioProcessor::doublePrecision))
+                        continue;
+
+                    modeCase.setUp(floatProcessor);
+                    modeCase.setUp(doubleProcessor);
+
+                    Result floatResult { "precision", modeCase.name + "/float", blockSize, numChannels };
+                    floatResult.nsPerUnit = timeProcessBlock<float>(floatProcessor, numChannels, blockSize, options, nullptr);
+
+                    Result doubleResult { "precision", modeCase.name + "/double", blockSize, numChannels };
+                    doubleResult.nsPerUnit = timeProcessBlock<double>(doubleProcessor, numChannels, blockSize, options, nullptr);
+
+                    results.add(floatResult);
+                    results.add(doubleResult);
+                    printResult(floatResult);
+                    printResult(doubleResult, "  x" + juce::String(doubleResult.nsPerUnit / floatResult.nsPerUnit, 2) + " of the float time");
+                }
+            }
+        }
+    }
+
+    void runSilenceSuite(const Options& options, juce::Array<Result>& results) //Idle tracks: silent input after the tail against noise
+    {
+        constexpr int blockSize = 512;
+
+        for (auto& modeCase : getModeCases())
+        {
+            if (modeCase.name == "programs") //Only moves the parameters, its static case is the default filter
+                continue;
+
+            for (auto numChannels : options.channelCounts)
+            {
+                MultiPluginAudioProcessor processor;
+
+                if (! configure(processor, numChannels, blockSize))
+                    continue;
+
+                modeCase.setUp(processor);
+                juce::MidiBuffer midiMessages;
+
+                Result noiseResult { "silence", modeCase.name + "/noise", blockSize, numChannels };
+                noiseResult.nsPerUnit = timeProcessBlock(processor, numChannels, blockSize, options, nullptr);
+
+                //Silence for the whole tail first, so every measured block is past it
+                juce::AudioBuffer<float> silence(numChannels, blockSize);
+                const auto tailBlocks = (int) std::ceil(processor.getTailLengthSeconds() * preparedSampleRate / blockSize) + 2;
+
+                for (int i = 0; i < tailBlocks; ++i)
+                {
+                    silence.clear();
+                    processor.processBlock(silence, midiMessages);
+                }
+
+                Result silenceResult { "silence", modeCase.name + "/silence", blockSize, numChannels };
+                silenceResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                {
+                    buffer.clear(); //Timed as well, it is what the host sends to an idle track
+                    processor.processBlock(buffer, midiMessages);
+                });
+
+                results.add(noiseResult);
+                results.add(silenceResult);
+                printResult(noiseResult, "  tail " + juce::String(processor.getTailLengthSeconds(), 3) + " s");
+                printResult(silenceResult, "  x" + juce::String(silenceResult.nsPerUnit / noiseResult.nsPerUnit, 3) + " of the noise time");
+            }
+        }
+    }
+
+    void runOversamplingSuite(const Options& options, juce::Array<Result>& results) //Cost and latency of every oversampling factor
+    {
+        const char* factorNames[] = { "off", "2x", "4x", "8x" };
+        const char* typeNames[] = { "iir", "fir" };
+
+        for (auto type : { OversamplingTypes::lowLatency, OversamplingTypes::linearPhase })
+        {
+            for (int factor = OversamplingFactors::off; factor <= OversamplingFactors::x8; ++factor)
+            {
+                if (factor == OversamplingFactors::off && type != OversamplingTypes::lowLatency) //The type does not matter without oversampling
+                    continue;
+
+                for (auto numChannels : options.channelCounts)
+                {
+                    for (auto blockSize : { 64, 512 })
+                    {
+                        MultiPluginAudioProcessor processor;
+                        setParameter(processor, ParameterIDs::pluginType, (float) PluginTypes::filter);
+                        setParameter(processor, ParameterIDs::filterFrequency, 1000.0f);
+                        setParameter(processor, ParameterIDs::filterResonance, 2.0f);
+                        setParameter(processor, ParameterIDs::filterOversampling, (float) factor);
+                        setParameter(processor, ParameterIDs::filterOversamplingType, (float) type);
+
+                        if (! configure(processor, numChannels, blockSize)) //Set after the parameters, prepareToPlay reports the latency to the host
+                            continue;
+
+                        Result result { "oversampling", juce::String(typeNames[type]) + "/" + factorNames[factor], blockSize, numChannels };
+                        result.nsPerUnit = timeProcessBlock(processor, numChannels, blockSize, options, nullptr);
+                        results.add(result);
+                        printResult(result, "  latency " + juce::String(processor.getLatencySamples()) + " samples");
+                    }
+                }
+            }
+        }
+    }
+
+    //==============================================================================
+    using FilterType = juce::dsp::StateVariableTPTFilterType;
+
+    template <typename Filter>
+    void setUpFilter(Filter& filter, FilterType filterType, int numChannels, int blockSize)
+    {
+        filter.prepare({ preparedSampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels });
+        filter.setType(filterType);
+        filter.setCutoffFrequency(1000.0f);
+        filter.setResonance(2.0f);
+    }
+
+    //Runs two filters on the same noise and compares the outputs
+    float getMaximumDifference(int numChannels, int blockSize, const std::function<void(juce::dsp::AudioBlock<float>&)>& processA,
+                               const std::function<void(juce::dsp::AudioBlock<float>&)>& processB)
+    {
+        juce::AudioBuffer<float> bufferA(numChannels, blockSize), bufferB(numChannels, blockSize);
+        juce::Random random(42);
+        float maximumDifference = 0.0f;
+
+        for (int blockIndex = 0; blockIndex < 64; ++blockIndex)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    bufferA.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            bufferB.makeCopyOf(bufferA, true);
+
+            juce::dsp::AudioBlock<float> blockA(bufferA), blockB(bufferB);
+            processA(blockA);
+            processB(blockB);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    maximumDifference = juce::jmax(maximumDifference, std::abs(bufferA.getSample(channel, i) - bufferB.getSample(channel, i)));
+        }
+
+        return maximumDifference;
+    }
+
+    float getMaximumDifference(FilterType filterType, int numChannels, int blockSize) //SIMD filter against the JUCE filter
+    {
+        juce::dsp::StateVariableTPTFilter<float> juceFilter;
+        SIMDStateVariableFilter<float> simdFilter;
+        setUpFilter(juceFilter, filterType, numChannels, blockSize);
+        setUpFilter(simdFilter, filterType, numChannels, blockSize);
+
+        return getMaximumDifference(numChannels, blockSize,
+                                    [&](juce::dsp::AudioBlock<float>& block) { juceFilter.process(juce::dsp::ProcessContextReplacing<float>(block)); },
+                                    [&](juce::dsp::AudioBlock<float>& block) { simdFilter.process(juce::dsp::ProcessContextReplacing<float>(block)); });
+    }
+
+    bool runCascadeCases(const Options& options, juce::Array<Result>& results) //Fused cascades against separate sections, and the ladder against the 24 dB/oct cascade
+    {
+        constexpr float tolerance = 1.0e-5f; //Same operations in the same order, the outputs only differ if the fused loop is wrong
+        constexpr int blockSize = 512;
+        constexpr float resonance = 2.0f;
+        bool allMatch = true;
+
+        for (int numSections = 2; numSections <= SIMDStateVariableFilter<float>::maximumNumSections; ++numSections)
+        {
+            for (auto numChannels : { 1, 2, 8 })
+            {
+                SIMDStateVariableFilter<float> fusedFilter;
+                setUpFilter(fusedFilter, FilterType::lowpass, numChannels, blockSize);
+                fusedFilter.setResonance(resonance);
+                fusedFilter.setNumSections(numSections);
+
+                std::vector<SIMDStateVariableFilter<float>> sections((size_t) numSections); //The same sections, each one going over the whole block
+
+                for (int section = 0; section < numSections; ++section)
+                {
+                    setUpFilter(sections[(size_t) section], FilterType::lowpass, numChannels, blockSize);
+                    sections[(size_t) section].setResonance((float) SIMDStateVariableFilter<float>::getSectionResonance(section, numSections, resonance, FilterType::lowpass));
+                }
+
+                auto processFused = [&](juce::dsp::AudioBlock<float>& block) { fusedFilter.process(juce::dsp::ProcessContextReplacing<float>(block)); };
+                auto processSections = [&](juce::dsp::AudioBlock<float>& block)
+                {
+                    for (auto& section : sections)
+                        section.process(juce::dsp::ProcessContextReplacing<float>(block));
+                };
+
+                const auto name = "lowpass" + juce::String(numSections * 12);
+                Result separateResult { "filterEngine", "separate/" + name, blockSize, numChannels };
+                separateResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                {
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    processSections(block);
+                });
+
+                Result fusedResult { "filterEngine", "fused/" + name, blockSize, numChannels };
+                fusedResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                {
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    processFused(block);
+                });
+
+                fusedFilter.reset();
+                for (auto& section : sections)
+                    section.reset();
+
+                const auto difference = getMaximumDifference(numChannels, blockSize, processSections, processFused);
+                allMatch = allMatch && difference <= tolerance;
+
+                results.add(separateResult);
+                results.add(fusedResult);
+                printResult(separateResult);
+                printResult(fusedResult, "  x" + juce::String(separateResult.nsPerUnit / fusedResult.nsPerUnit, 2)
+                                         + "  max difference " + juce::String(difference, 8) + (difference <= tolerance ? "" : "  MISMATCH"));
+
+                if (numSections == 2) //The ladder has the same slope as 2 sections
+                {
+                    SIMDLadderFilter<float> ladderFilter;
+                    setUpFilter(ladderFilter, FilterType::lowpass, numChannels, blockSize);
+
+                    Result ladderResult { "filterEngine", "ladder/lowpass24", blockSize, numChannels };
+                    ladderResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                    {
+                        juce::dsp::AudioBlock<float> block(buffer);
+                        ladderFilter.process(juce::dsp::ProcessContextReplacing<float>(block));
+                    });
+
+                    results.add(ladderResult);
+                    printResult(ladderResult, "  x" + juce::String(fusedResult.nsPerUnit / ladderResult.nsPerUnit, 2) + " against the fused cascade");
+                }
+            }
+        }
+
+        return allMatch;
+    }
+
+    bool runModulationCases(const Options& options, juce::Array<Result>& results) //Cutoff set at every sample against the ramped control rates
+    {
+        constexpr float tolerance = 5.0e-2f; //The ramps follow the curve of the sweep in straight lines, about 1e-2 at 32 samples and 3e-2 at 64 on full scale noise
+        constexpr int blockSize = 512;
+        bool allMatch = true;
+
+        //A filter swept by a 5 Hz LFO over 2 octaves, with the cutoff set every controlRate samples (1 is every sample, without a ramp)
+        struct Sweep
+        {
+            Sweep(int numChannels, int rate) : controlRate((size_t) rate)
+            {
+                setUpFilter(filter, FilterType::lowpass, numChannels, blockSize);
+                filter.setCoefficientRamping(controlRate > 1);
+                modulation.prepare(preparedSampleRate);
+                modulation.setLfoRate(5.0f);
+                modulation.setLfoDepths(2.0f, 0.0f);
+            }
+
+            void process(juce::dsp::AudioBlock<float>& block)
+            {
+                for (size_t start = 0; start < block.getNumSamples(); start += controlRate)
+                {
+                    auto chunk = block.getSubBlock(start, juce::jmin(controlRate, block.getNumSamples() - start));
+                    filter.setCutoffFrequency(1000.0f * std::exp2(modulation.advance(chunk).cutoffOctaves));
+                    filter.process(juce::dsp::ProcessContextReplacing<float>(chunk));
+                }
+            }
+
+            SIMDStateVariableFilter<float> filter;
+            FilterModulation<float> modulation;
+            size_t controlRate;
+        };
+
+        for (auto numChannels : { 1, 2, 8 })
+        {
+            Sweep exactSweep(numChannels, 1);
+            Result exactResult { "filterEngine", "modulation/everySample", blockSize, numChannels };
+            exactResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                exactSweep.process(block);
+            });
+
+            results.add(exactResult);
+            printResult(exactResult);
+
+            for (auto controlRate : { 8, 16, 32, 64 })
+            {
+                Sweep rampedSweep(numChannels, controlRate);
+                Result rampedResult { "filterEngine", "modulation/step" + juce::String(controlRate), blockSize, numChannels };
+                rampedResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                {
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    rampedSweep.process(block);
+                });
+
+                Sweep exact(numChannels, 1), ramped(numChannels, controlRate); //Both start from the same state
+                const auto difference = getMaximumDifference(numChannels, blockSize, [&](juce::dsp::AudioBlock<float>& block) { exact.process(block); },
+                                                             [&](juce::dsp::AudioBlock<float>& block) { ramped.process(block); });
+                allMatch = allMatch && difference <= tolerance;
+
+                results.add(rampedResult);
+                printResult(rampedResult, "  x" + juce::String(exactResult.nsPerUnit / rampedResult.nsPerUnit, 2)
+                                          + "  max difference " + juce::String(difference, 8) + (difference <= tolerance ? "" : "  MISMATCH"));
+            }
+        }
+
+        return allMatch;
+    }
+
+    bool runFilterEngineSuite(const Options& options, juce::Array<Result>& results) //Compares the SIMD filter with the JUCE filter it replaced
+    {
+        constexpr float tolerance = 1.0e-4f; //Both filters run in float, only the rounding of the operations differs
+        const std::pair<FilterType, const char*> filterTypes[] = { { FilterType::lowpass, "lowpass" }, { FilterType::bandpass, "bandpass" }, { FilterType::highpass, "highpass" } };
+        bool allMatch = true;
+
+        for (auto& [filterType, typeName] : filterTypes)
+        {
+            for (auto numChannels : { 1, 2, 4, 8, 16 })
+            {
+                for (auto blockSize : { 64, 512 })
+                {
+                    juce::dsp::StateVariableTPTFilter<float> juceFilter;
+                    SIMDStateVariableFilter<float> simdFilter;
+                    setUpFilter(juceFilter, filterType, numChannels, blockSize);
+                    setUpFilter(simdFilter, filterType, numChannels, blockSize);
+
+                    Result juceResult { "filterEngine", juce::String("juce/") + typeName, blockSize, numChannels };
+                    juceResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                    {
+                        juce::dsp::AudioBlock<float> block(buffer);
+                        juceFilter.process(juce::dsp::ProcessContextReplacing<float>(block));
+                    });
+
+                    Result simdResult { "filterEngine", juce::String("simd/") + typeName, blockSize, numChannels };
+                    simdResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                    {
+                        juce::dsp::AudioBlock<float> block(buffer);
+                        simdFilter.process(juce::dsp::ProcessContextReplacing<float>(block));
+                    });
+
+                    const auto difference = getMaximumDifference(filterType, numChannels, blockSize);
+                    allMatch = allMatch && difference <= tolerance;
+
+                    results.add(juceResult);
+                    results.add(simdResult);
+                    printResult(juceResult);
+                    printResult(simdResult, "  x" + juce::String(juceResult.nsPerUnit / simdResult.nsPerUnit, 2)
+                                            + "  max difference " + juce::String(difference, 8) + (difference <= tolerance ? "" : "  MISMATCH"));
+                }
+            }
+        }
+
+        const auto cascadesMatch = runCascadeCases(options, results);
+        return runModulationCases(options, results) && cascadesMatch && allMatch;
+    }
+
+    //==============================================================================
+    void runMultibandSuite(const Options& options, juce::Array<Result>& results) //Multiband compressor against the broadband one
+    {
+        constexpr int blockSize = 512;
+
+        for (auto numChannels : { 1, 2, 4, 8, 16 })
+        {
+            const juce::dsp::ProcessSpec spec { preparedSampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels };
+
+            MultiChannelCompressor<float> broadband;
+            broadband.prepare(spec);
+            broadband.setThreshold(-20.0f);
+            broadband.setRatio(4.0f);
+            broadband.setAttack(5.0f);
+            broadband.setRelease(100.0f);
+
+            Result broadbandResult { "multiband", "broadband", blockSize, numChannels };
+            broadbandResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                broadband.process(juce::dsp::ProcessContextReplacing<float>(block));
+            });
+
+            results.add(broadbandResult);
+            printResult(broadbandResult);
+
+            for (auto numBands : { 3, 4 })
+            {
+                MultibandCompressor<float> multiband;
+                multiband.prepare(spec);
+                multiband.setNumBands(numBands);
+                multiband.setRatio(4.0f);
+                multiband.setAttack(5.0f);
+                multiband.setRelease(100.0f);
+
+                for (int band = 0; band < numBands; ++band)
+                    multiband.setThreshold(band, -20.0f);
+
+                Result multibandResult { "multiband", juce::String(numBands) + " bands", blockSize, numChannels };
+                multibandResult.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                {
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    multiband.process(juce::dsp::ProcessContextReplacing<float>(block));
+                });
+
+                results.add(multibandResult);
+                printResult(multibandResult, "  x" + juce::String(multibandResult.nsPerUnit / broadbandResult.nsPerUnit, 2) + " of the broadband cost");
+            }
+        }
+    }
+
+    //==============================================================================
+    void runDetectorSuite(const Options& options, juce::Array<Result>& results) //Detectors and linking of the compressor
+    {
+        constexpr int blockSize = 512;
+
+        struct DetectorCase
+        {
+            const char* name;
+            bool rms, linked;
+            float linkAmount, kneedB, windowMs;
+            bool keyed; //Keyed by the sidechain instead of the block itself
+            float highpassHz; //Highpass of the key (0 is off)
+            const char* comparedWith; //Earlier case the time is compared with
+        };
+
+        const DetectorCase detectorCases[] = {
+            { "peak/unlinked", false, false, 1.0f, 0.0f, 10.0f, false, 0.0f, nullptr },
+            { "peak/linked", false, true, 1.0f, 0.0f, 10.0f, false, 0.0f, "peak/unlinked" },
+            { "peak/linked50", false, true, 0.5f, 0.0f, 10.0f, false, 0.0f, "peak/unlinked" },
+            { "peak/knee", false, false, 1.0f, 12.0f, 10.0f, false, 0.0f, "peak/unlinked" },
+            { "rms/unlinked", true, false, 1.0f, 0.0f, 10.0f, false, 0.0f, "peak/unlinked" },
+            { "rms/linked", true, true, 1.0f, 0.0f, 10.0f, false, 0.0f, "rms/unlinked" },
+            { "rms/window1", true, false, 1.0f, 0.0f, 1.0f, false, 0.0f, nullptr },
+            { "rms/window50", true, false, 1.0f, 0.0f, 50.0f, false, 0.0f, "rms/window1" },
+            { "peak/sidechain", false, false, 1.0f, 0.0f, 10.0f, true, 0.0f, "peak/unlinked" },
+            { "peak/sidechainHighpass", false, false, 1.0f, 0.0f, 10.0f, true, 100.0f, "peak/sidechain" }
+        };
+
+        for (auto numChannels : { 2, 8, 16 })
+        {
+            const juce::dsp::ProcessSpec spec { preparedSampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels };
+            std::map<juce::String, double> nsPerCase;
+
+            juce::AudioBuffer<float> keyBuffer(numChannels, blockSize); //Stands for the sidechain bus, the compressor reads it in place
+            juce::Random random(5678);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    keyBuffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            const juce::dsp::AudioBlock<float> keyBlock(keyBuffer);
+
+            for (auto& detectorCase : detectorCases)
+            {
+                MultiChannelCompressor<float> compressor;
+                compressor.prepare(spec);
+                compressor.setThreshold(-20.0f);
+                compressor.setRatio(4.0f);
+                compressor.setAttack(5.0f);
+                compressor.setRelease(100.0f);
+                compressor.setRmsDetector(detectorCase.rms);
+                compressor.setRmsWindow(detectorCase.windowMs);
+                compressor.setLinked(detectorCase.linked);
+                compressor.setLinkAmount(detectorCase.linkAmount);
+                compressor.setKnee(detectorCase.kneedB);
+                compressor.setKeyHighpass(detectorCase.highpassHz);
+
+                Result result { "detector", detectorCase.name, blockSize, numChannels };
+                result.nsPerUnit = timeBlocks(numChannels, blockSize, options, nullptr, [&](juce::AudioBuffer<float>& buffer)
+                {
+                    juce::dsp::AudioBlock<float> block(buffer);
+
+                    if (detectorCase.keyed)
+                        compressor.process(juce::dsp::ProcessContextReplacing<float>(block), keyBlock);
+                    else
+                        compressor.process(juce::dsp::ProcessContextReplacing<float>(block));
+                });
+
+                nsPerCase[detectorCase.name] = result.nsPerUnit;
+                results.add(result);
+
+                if (detectorCase.comparedWith != nullptr)
+                    printResult(result, "  x" + juce::String(result.nsPerUnit / nsPerCase[detectorCase.comparedWith], 2) + " of " + detectorCase.comparedWith);
+                else
+                    printResult(result);
+            }
+        }
+    }
+
+    //==============================================================================
+    template <typename SampleType>
+    bool runFastMathCases(const Options& options, juce::Array<Result>& results, const juce::String& typeName) //Every approximation of FastMath in one precision
+    {
+        using Function = FastMath::Function;
+        using Reference = long double; //The std:: functions in a wider type than the checked one (Only as wide as double with MSVC, the bounds leave room for it)
+        using Limits = std::numeric_limits<SampleType>;
+        using Block = std::function<void(SampleType*, const SampleType*, int)>;
+
+        constexpr int numValues = 4096; //Values of a timed block (In the L1 cache, like a block of envelopes)
+        constexpr int numChecked = 1 << 20; //Values the error is checked on, spread over the whole domain
+        constexpr int blocksPerRepetition = 64;
+
+        const auto maximumdB = (Reference) (Limits::max_exponent - 2) * 20.0L * std::log10(2.0L); //dB of the normal numbers
+        const auto noFloor = (SampleType) -Limits::max(); //minusInfinitydB under the whole domain, so no value reads as silence
+
+        struct Case
+        {
+            Function function;
+            const char* name;
+            Reference minimum, maximum; //Domain
+            bool logarithmic; //The values are 2^x with x from the minimum to the maximum
+            std::function<Reference(Reference)> reference;
+            Block exact, fast;
+        };
+
+        const Case cases[] =
+        {
+            { Function::tan, "tan", -0.9999L * juce::MathConstants<Reference>::halfPi, 0.9999L * juce::MathConstants<Reference>::halfPi, false,
+              [](Reference x) { return std::tan(x); },
+              [](SampleType* d, const SampleType* s, int n) { for (int i = 0; i < n; ++i) d[i] = std::tan(s[i]); },
+              [](SampleType* d, const SampleType* s, int n) { for (int i = 0; i < n; ++i) d[i] = FastMath::tan(s[i]); } },
+            { Function::exp2, "exp2", (Reference) Limits::min_exponent, (Reference) (Limits::max_exponent - 1), false,
+              [](Reference x) { return std::exp2(x); },
+              [](SampleType* d, const SampleType* s, int n) { for (int i = 0; i < n; ++i) d[i] = std::exp2(s[i]); },
+              [](SampleType* d, const SampleType* s, int n) { FastMath::exp2(d, s, n); } },
+            { Function::log2, "log2", (Reference) Limits::min_exponent, (Reference) (Limits::max_exponent - 1), true,
+              [](Reference x) { return std::log2(x); },
+              [](SampleType* d, const SampleType* s, int n) { for (int i = 0; i < n; ++i) d[i] = std::log2(s[i]); },
+              [](SampleType* d, const SampleType* s, int n) { FastMath::log2(d, s, n); } },
+            { Function::decibelsToGain, "decibelsToGain", -maximumdB, maximumdB, false,
+              [](Reference x) { return std::pow(10.0L, x / 20.0L); },
+              [=](SampleType* d, const SampleType* s, int n) { for (int i = 0; i < n; ++i) d[i] = juce::Decibels::decibelsToGain(s[i], noFloor); },
+              [=](SampleType* d, const SampleType* s, int n) { FastMath::decibelsToGain(d, s, n, noFloor); } },
+            { Function::gainToDecibels, "gainToDecibels", (Reference) Limits::min_exponent, (Reference) (Limits::max_exponent - 1), true,
+              [](Reference x) { return 20.0L * std::log10(x); },
+              [=](SampleType* d, const SampleType* s, int n) { for (int i = 0; i < n; ++i) d[i] = juce::Decibels::gainToDecibels(s[i], noFloor); },
+              [=](SampleType* d, const SampleType* s, int n) { FastMath::gainToDecibels(d, s, n, noFloor); } },
+        };
+
+        auto getValue = [](const Case& c, int index, int count) //Middle of the index-th of count steps over the domain (Never exactly 0 or 1, where the relative error has no meaning)
+        {
+            const auto x = c.minimum + (c.maximum - c.minimum) * ((Reference) index + 0.5L) / (Reference) count;
+            return (SampleType) (c.logarithmic ? std::exp2(x) : x);
+        };
+
+        bool allMatch = true;
+        std::vector<SampleType> source((size_t) numValues), destination((size_t) numValues);
+
+        for (auto& c : cases)
+        {
+            //Largest relative error over the domain
+            double maximumError = 0.0;
+
+            for (int start = 0; start < numChecked; start += numValues)
+            {
+                for (int i = 0; i < numValues; ++i)
+                    source[(size_t) i] = getValue(c, start + i, numChecked);
+
+                c.fast(destination.data(), source.data(), numValues);
+
+                for (int i = 0; i < numValues; ++i)
+                {
+                    const auto expected = c.reference((Reference) source[(size_t) i]);
+                    const auto error = std::abs(expected == 0 ? (Reference) destination[(size_t) i] : (Reference) destination[(size_t) i] / expected - 1.0L);
+                    maximumError = juce::jmax(maximumError, (double) error);
+                }
+            }
+
+            const auto bound = FastMath::maximumError<SampleType>(c.function);
+            allMatch = allMatch && maximumError <= bound;
+
+            //Median time per value of the std:: (Or juce::Decibels) function and of the approximation, on one block spread over the domain
+            for (int i = 0; i < numValues; ++i)
+                source[(size_t) i] = getValue(c, i, numValues);
+
+            auto timeValues = [&](const Block& run)
+            {
+                return timeRepetitions(options, blocksPerRepetition * numValues, [&](int)
+                {
+                    for (int block = 0; block < blocksPerRepetition; ++block)
+                        run(destination.data(), source.data(), numValues);
+                });
+            };
+
+            Result exactResult { "fastMath", typeName + "/" + c.name + "/std", numValues, 1, false, timeValues(c.exact), "value" };
+            Result fastResult { "fastMath", typeName + "/" + c.name + "/fast", numValues, 1, false, timeValues(c.fast), "value" };
+            addResult(results, exactResult);
+            addResult(results, fastResult, "  x" + juce::String(exactResult.nsPerUnit / fastResult.nsPerUnit, 2) + "  max error " + juce::String(maximumError, 3)
+                                           + " (bound " + juce::String(bound, 3) + ")" + (maximumError <= bound ? "" : "  OUT OF BOUND"));
+        }
+
+        return allMatch;
+    }
+
+    bool runFastMathSuite(const Options& options, juce::Array<Result>& results) //Approximations against the std:: functions, for speed and error
+    {
+        const auto floatMatches = runFastMathCases<float>(options, results, "float");
+        return runFastMathCases<double>(options, results, "double") && floatMatches;
+    }
+
+    //==============================================================================
+    bool runStateSuite(const Options& options, juce::Array<Result>& results) //Save and restore of the state of many instances (Like a host opening a session)
+    {
+        constexpr int numInstances = 1000;
+        std::vector<std::unique_ptr<MultiPluginAudioProcessor>> processors;
+        juce::Random random(1234);
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            processors.push_back(std::make_unique<MultiPluginAudioProcessor>());
+
+            for (auto* parameter : processors.back()->getParameters()) //Every instance gets different settings
+                parameter->setValueNotifyingHost(random.nextFloat());
+        }
+
+        std::vector<juce::MemoryBlock> states((size_t) numInstances);
+        bool allMatch = true;
+
+        //Returns the median time per instance in ns, every instance restores the state of the next one so every value really changes
+        auto timeInstances = [&](const std::function<void(MultiPluginAudioProcessor&, juce::MemoryBlock&)>& run, bool restoring)
+        {
+            return timeRepetitions(options, numInstances, [&](int repetition)
+            {
+                for (int i = 0; i < numInstances; ++i)
+                    run(*processors[(size_t) i], states[(size_t) (restoring ? (i + 1 + repetition) % numInstances : i)]);
+            });
+        };
+
+        //Binary format, through the same calls as the host
+        const auto binarySave = timeInstances([](MultiPluginAudioProcessor& processor, juce::MemoryBlock& state) { processor.getStateInformation(state); }, false);
+        addResult(results, { "state", "binary/save", 0, 0, false, binarySave, "instance" }, "  " + juce::String((int) states.front().getSize()) + " bytes");
+
+        const auto binaryRestore = timeInstances([](MultiPluginAudioProcessor& processor, juce::MemoryBlock& state) { processor.setStateInformation(state.getData(), (int) state.getSize()); }, true);
+        addResult(results, { "state", "binary/restore", 0, 0, false, binaryRestore, "instance" });
+
+        for (int i = 0; i < numInstances; ++i) //The last restore has to give back the state that was read (The values can only differ by the rounding of the range conversion)
+        {
+            juce::MemoryBlock state;
+            processors[(size_t) i]->getStateInformation(state);
+            const auto& expected = states[(size_t) ((i + options.repetitions) % numInstances)];
+            allMatch = allMatch && state.getSize() == expected.getSize() && std::memcmp(state.getData(), expected.getData(), 8) == 0; //Same header
+
+            for (size_t offset = 8; allMatch && offset < state.getSize(); offset += 8) //Same ID hashes and values in the entries of PluginState
+            {
+                const auto* value = static_cast<const char*>(state.getData()) + offset;
+                const auto* expectedValue = static_cast<const char*>(expected.getData()) + offset;
+                float restoredFloat, expectedFloat;
+                std::memcpy(&restoredFloat, value + 4, sizeof(float));
+                std::memcpy(&expectedFloat, expectedValue + 4, sizeof(float));
+                allMatch = std::memcmp(value, expectedValue, 4) == 0 && std::abs(restoredFloat - expectedFloat) <= 1.0e-4f * juce::jmax(1.0f, std::abs(expectedFloat));
+            }
+        }
+
+        if (! allMatch)
+            print("binary/restore          MISMATCH");
+
+        //XML of the value tree (The debug format and the usual JUCE way)
+        const auto xmlSave = timeInstances([](MultiPluginAudioProcessor& processor, juce::MemoryBlock& state)
+        {
+            state.reset();
+
+            if (auto xml = processor.parameters.copyState().createXml())
+                juce::AudioProcessor::copyXmlToBinary(*xml, state);
+        }, false);
+        addResult(results, { "state", "xml/save", 0, 0, false, xmlSave, "instance" }, "  " + juce::String((int) states.front().getSize()) + " bytes  x" + juce::String(xmlSave / binarySave, 2) + " of the binary time");
+
+        const auto xmlRestore = timeInstances([](MultiPluginAudioProcessor& processor, juce::MemoryBlock& state)
+        {
+            if (auto xml = juce::AudioProcessor::getXmlFromBinary(state.getData(), (int) state.getSize()))
+                processor.parameters.replaceState(juce::ValueTree::fromXml(*xml));
+        }, true);
+        addResult(results, { "state", "xml/restore", 0, 0, false, xmlRestore, "instance" }, "  x" + juce::String(xmlRestore / binaryRestore, 2) + " of the binary time");
+
+        return allMatch;
+    }
+
+    bool runRealtimeSuite(const Options& options, juce::Array<Result>& results) //Drives every mode through parameter and program changes with the realtime checker on
+    {
+       #if MULTIPLUGIN_RT_CHECK
+        constexpr int blockSize = 256;
+        constexpr int numBlocks = 400;
+        RealtimeCheck::setFailureMode(RealtimeCheck::FailureMode::report);
+        bool passed = true;
+
+        for (auto& modeCase : getModeCases())
+        {
+            for (auto precision : { juce::AudioProcessor::singlePrecision, juce::AudioProcessor::doublePrecision })
+            {
+                for (auto numChannels : options.channelCounts)
+                {
+                    MultiPluginAudioProcessor processor;
+
+                    if (! configure(processor, numChannels, blockSize, precision))
+                        continue;
+
+                    modeCase.setUp(processor);
+                    processor.setMeteringEnabled(true); //The meters and the analyzer only publish while the editor is open
+                    processor.setAnalyzerEnabled(true);
+
+                    juce::AudioBuffer<float> floatBuffer(numChannels, blockSize);
+                    juce::AudioBuffer<double> doubleBuffer(numChannels, blockSize);
+                    juce::MidiBuffer midiMessages;
+                    juce::Random random(1234);
+                    RealtimeCheck::resetViolations();
+                    const auto start = juce::Time::getHighResolutionTicks();
+
+                    for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+                    {
+                        modeCase.move(processor, blockIndex);
+
+                        if (blockIndex % 50 == 25) //Every parameter jumps at once (Mode, oversampling, bands, chain stages...)
+                            for (auto* parameter : processor.getParameters())
+                                parameter->setValueNotifyingHost(random.nextFloat());
+
+                        if (blockIndex % 100 == 99)
+                            processor.reset();
+
+                        const auto isSilent = (blockIndex / 100) % 2 == 1 && blockIndex % 100 >= 50; //Silent stretches, so the processor suspends and wakes up
+
+                        for (int channel = 0; channel < numChannels; ++channel)
+                        {
+                            for (int i = 0; i < blockSize; ++i)
+                            {
+                                const auto sample = isSilent ? 0.0f : random.nextFloat() * 2.0f - 1.0f;
+                                floatBuffer.setSample(channel, i, sample);
+                                doubleBuffer.setSample(channel, i, sample);
+                            }
+                        }
+
+                        if (precision == juce::AudioProcessor::doublePrecision)
+                            processor.processBlock(doubleBuffer, midiMessages);
+                        else
+                            processor.processBlock(floatBuffer, midiMessages);
+                    }
+
+                    const auto numViolations = RealtimeCheck::getNumViolations();
+                    const auto name = modeCase.name + (precision == juce::AudioProcessor::doublePrecision ? "/double" : "/float");
+                    Result result { "realtime", name, blockSize, numChannels, true };
+                    result.nsPerUnit = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9 / (numBlocks * blockSize);
+                    results.add(result);
+                    printResult(result, numViolations == 0 ? juce::String("  ok") : "  " + juce::String(numViolations) + " VIOLATIONS");
+                    passed = passed && numViolations == 0;
+                }
+            }
+        }
+
+        return passed;
+       #else
+        juce::ignoreUnused(options, results);
+        print("The realtime checker is compiled out, build with MULTIPLUGIN_RT_CHECK=1 to run this suite");
+        return false;
+       #endif
+    }
+
+    void runEditorSuite(const Options& options, juce::Array<Result>& results) //Paint time of many open editors (Like a session with a window per track)
+    {
+        constexpr int numEditors = 50;
+        constexpr int framesPerRepetition = 10;
+        std::vector<std::unique_ptr<MultiPluginAudioProcessor>> processors;
+        std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors; //Declared after the processors so they are deleted first
+        std::vector<juce::Slider*> knobs; //First rotary slider of every editor (The frequency knob of the filter mode)
+
+        for (int i = 0; i < numEditors; ++i)
+        {
+            processors.push_back(std::make_unique<MultiPluginAudioProcessor>());
+            editors.emplace_back(processors.back()->createEditor());
+
+            for (auto* child : editors.back()->getChildren())
+                if (auto* slider = dynamic_cast<juce::Slider*>(child); slider != nullptr && slider->isVisible() && slider->getSliderStyle() == juce::Slider::Rotary)
+                    knobs.push_back(slider);
+
+            if (knobs.size() != editors.size())
+            {
+                print("No knob found in the editor");
+                return;
+            }
+        }
+
+        juce::SharedResourcePointer<MultiPluginLookAndFeel> lookAndFeel; //Same instance as the one of the editors
+        juce::Image frame(juce::Image::ARGB, editors.front()->getWidth(), editors.front()->getHeight(), true);
+
+        //Returns the median time of one frame of one editor in ns. A knob frame moves the knob and only paints its bounds, like the repaint of a drag.
+        auto timeFrames = [&](bool knobOnly)
+        {
+            return timeRepetitions(options, framesPerRepetition * numEditors, [&](int)
+            {
+                for (int frameIndex = 0; frameIndex < framesPerRepetition; ++frameIndex)
+                {
+                    for (size_t i = 0; i < editors.size(); ++i)
+                    {
+                        juce::Graphics g(frame);
+
+                        if (knobOnly)
+                        {
+                            knobs[i]->setValue(knobs[i]->proportionOfLengthToValue((frameIndex + 0.5) / framesPerRepetition), juce::sendNotificationSync);
+                            g.reduceClipRegion(knobs[i]->getBounds());
+                        }
+
+                        editors[i]->paintEntireComponent(g, false);
+                    }
+                }
+            });
+        };
+
+        auto getCoreShare = [&](double nsPerFrame) //Share of a core for every editor at 60 fps
+        {
+            return "  " + juce::String(nsPerFrame * numEditors * 60.0 * 1.0e-7, 1) + "% of a core for " + juce::String(numEditors) + " editors at 60 fps";
+        };
+
+        //Whole window, with the arcs rendered every time (Like LookAndFeel_V4) and from the image cache
+        lookAndFeel->setImageCachingEnabled(false);
+        const auto fullUncached = timeFrames(false);
+        addResult(results, { "editor", "full/uncached", 0, 0, false, fullUncached, "frame" }, getCoreShare(fullUncached));
+
+        lookAndFeel->setImageCachingEnabled(true);
+        const auto fullCached = timeFrames(false);
+        addResult(results, { "editor", "full/cached", 0, 0, false, fullCached, "frame" }, getCoreShare(fullCached) + "  x" + juce::String(fullCached / fullUncached, 2) + " of the uncached time");
+
+        //Dragged knob, with the juce::GlowEffect the editor used to set (It renders the knob offscreen and blurs it on every repaint)
+        juce::GlowEffect glowEffect;
+        glowEffect.setGlowProperties(5, juce::Colour(0x1fff88ff));
+        lookAndFeel->setImageCachingEnabled(false);
+
+        for (auto* knob : knobs)
+            knob->setComponentEffect(&glowEffect);
+
+        const auto knobGlowEffect = timeFrames(true);
+        addResult(results, { "editor", "knob/glow effect", 0, 0, false, knobGlowEffect, "frame" }, getCoreShare(knobGlowEffect));
+
+        for (auto* knob : knobs)
+        {
+            knob->setComponentEffect(nullptr);
+            MultiPluginLookAndFeel::setGlowing(*knob, true); //What the editor does now when a drag starts
+        }
+
+        lookAndFeel->setImageCachingEnabled(true);
+        const auto knobCachedGlow = timeFrames(true);
+        addResult(results, { "editor", "knob/cached glow", 0, 0, false, knobCachedGlow, "frame" }, getCoreShare(knobCachedGlow) + "  x" + juce::String(knobCachedGlow / knobGlowEffect, 2) + " of the glow effect time");
+
+        for (auto* knob : knobs)
+            MultiPluginLookAndFeel::setGlowing(*knob, false);
+    }
+
+    //==============================================================================
+    void writeCsv(const juce::Array<Result>& results, const juce::File& file)
+    {
+        juce::String csv = "suite,case,block_size,channels,parameters,ns,unit";
+
+        for (auto sampleRate : sampleRates)
+            csv << ",realtime_percent_" << (int) sampleRate;
+
+        csv << "\n";
+
+        for (auto& result : results)
+        {
+            csv << result.suite << "," << result.name << "," << result.blockSize << "," << result.numChannels << ","
+                << (result.movingParameters ? "moving" : "static") << "," << juce::String(result.nsPerUnit, 4) << "," << result.unit;
+
+            for (auto sampleRate : sampleRates) //Empty when the time is not per sample frame
+                csv << "," << (result.isPerSample() ? juce::String(result.getRealtimePercent(sampleRate), 6) : juce::String());
+
+            csv << "\n";
+        }
+
+        file.replaceWithText(csv);
+    }
+
+    void writeJson(const juce::Array<Result>& results, const juce::File& file)
+    {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("version", ProjectInfo::versionString);
+        root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("cores", juce::SystemStats::getNumCpus());
+
+        juce::Array<juce::var> items;
+
+        for (auto& result : results)
+        {
+            auto* item = new juce::DynamicObject();
+            item->setProperty("key", result.getKey());
+            item->setProperty("suite", result.suite);
+            item->setProperty("case", result.name);
+            item->setProperty("block_size", result.blockSize);
+            item->setProperty("channels", result.numChannels);
+            item->setProperty("parameters", result.movingParameters ? "moving" : "static");
+            item->setProperty("ns", result.nsPerUnit);
+            item->setProperty("unit", result.unit);
+
+            if (result.isPerSample())
+                for (auto sampleRate : sampleRates)
+                    item->setProperty("realtime_percent_" + juce::String((int) sampleRate), result.getRealtimePercent(sampleRate));
+
+            items.add(juce::var(item));
+        }
+
+        root->setProperty("results", items);
+        file.replaceWithText(juce::JSON::toString(juce::var(root)));
+    }
+
+    int compareWithBaseline(const juce::Array<Result>& results, const Options& options) //Returns the number of regressions
+    {
+        const auto baseline = juce::JSON::parse(options.baselineFile);
+
+        if (! baseline.isObject())
+        {
+            print("Cannot read the baseline " + options.baselineFile.getFullPathName());
+            return 1;
+        }
+
+        std::map<juce::String, double> baselineTimes; //Keyed by the key and the unit, so a time is only compared with a time of the same unit
+
+        if (auto* items = baseline["results"].getArray())
+            for (auto& item : *items)
+                if (item.hasProperty("unit")) //Older baselines only had ns_per_sample, which also held the times per value, instance and frame
+                    baselineTimes[item["key"].toString() + " " + item["unit"].toString()] = (double) item["ns"];
+                else
+                    baselineTimes[item["key"].toString() + " sample"] = (double) item["ns_per_sample"];
+
+        int numRegressions = 0;
+        print("\nComparison with " + options.baselineFile.getFileName() + " (version " + baseline["version"].toString() + ")");
+
+        for (auto& result : results)
+        {
+            const auto found = baselineTimes.find(result.getKey() + " " + result.unit);
+
+            if (found == baselineTimes.end() || found->second <= 0.0)
+                continue;
+
+            const auto changePercent = (result.nsPerUnit / found->second - 1.0) * 100.0;
+
+            if (changePercent > options.tolerancePercent)
+            {
+                print("REGRESSION " + result.getKey() + ": " + juce::String(found->second, 2) + " -> " + juce::String(result.nsPerUnit, 2)
+                      + " ns/" + result.unit + " (+" + juce::String(changePercent, 1) + " %)");
+                ++numRegressions;
+            }
+        }
+
+        print(juce::String(numRegressions) + " regression(s) above " + juce::String(options.tolerancePercent, 1) + " %");
+        return numRegressions;
+    }
+
+    //==============================================================================
+    bool parseArguments(const juce::StringArray& arguments, Options& options)
+    {
+        for (int i = 0; i < arguments.size(); ++i)
+        {
+            const auto& argument = arguments[i];
+            const auto hasValue = i + 1 < arguments.size();
+            auto getFile = [&] { return juce::File::getCurrentWorkingDirectory().getChildFile(arguments[++i]); };
+
+            if (argument == "--suite" && hasValue)             options.suite = arguments[++i];
+            else if (argument == "--seconds" && hasValue)      options.secondsPerCase = juce::jmax(0.001, arguments[++i].getDoubleValue());
+            else if (argument == "--repetitions" && hasValue)  options.repetitions = juce::jmax(1, arguments[++i].getIntValue());
+            else if (argument == "--csv" && hasValue)          options.csvFile = getFile();
+            else if (argument == "--json" && hasValue)         options.jsonFile = getFile();
+            else if (argument == "--compare" && hasValue)      options.baselineFile = getFile();
+            else if (argument == "--tolerance" && hasValue)    options.tolerancePercent = arguments[++i].getDoubleValue();
+            else if (argument == "--channels" && hasValue)
+            {
+                options.channelCounts.clear();
+
+                for (auto& count : juce::StringArray::fromTokens(arguments[++i], ",", {}))
+                    options.channelCounts.add(juce::jmax(1, count.getIntValue()));
+            }
+            else return false;
+        }
+
+        return true;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; //The parameters need a message manager, no window is ever created
+
+    juce::StringArray arguments;
+
+    for (int i = 1; i < argc; ++i)
+        arguments.add(juce::CharPointer_UTF8(argv[i]));
+
+    Options options;
+
+    if (! parseArguments(arguments, options))
+    {
+        print("Usage: Multi-Plugin-Benchmark [--suite processBlock|filterEngine|oversampling|multiband|detector|fastMath|precision|silence|state|editor|realtime|all] [--seconds <s>] [--repetitions <n>]\n"
+              "                              [--channels <1,2,...>] [--csv <file>] [--json <file>] [--compare <baseline.json>] [--tolerance <percent>]");
+        return 1;
+    }
+
+    print("Multi-Plugin benchmark on " + juce::SystemStats::getCpuModel() + " (" + juce::String(juce::SystemStats::getNumCpus()) + " cores)\n");
+
+    juce::Array<Result> results;
+    const auto runAll = options.suite == "all";
+    bool passed = true; //Suites that also check the output of the DSP set this to false when it is wrong
+
+    if (runAll || options.suite == "processBlock")
+        runProcessBlockSuite(options, results);
+
+    if (runAll || options.suite == "filterEngine")
+        passed = runFilterEngineSuite(options, results) && passed;
+
+    if (runAll || options.suite == "oversampling")
+        runOversamplingSuite(options, results);
+
+    if (runAll || options.suite == "multiband")
+        runMultibandSuite(options, results);
+
+    if (runAll || options.suite == "detector")
+        runDetectorSuite(options, results);
+
+    if (runAll || options.suite == "fastMath")
+        passed = runFastMathSuite(options, results) && passed;
+
+    if (runAll || options.suite == "precision")
+        runPrecisionSuite(options, results);
+
+    if (runAll || options.suite == "silence")
+        runSilenceSuite(options, results);
+
+    if (runAll || options.suite == "state")
+        passed = runStateSuite(options, results) && passed;
+
+    if (runAll || options.suite == "editor")
+        runEditorSuite(options, results);
+
+    if (options.suite == "realtime") //Not part of all, it needs its own build
+        passed = runRealtimeSuite(options, results) && passed;
+
+    if (results.isEmpty() && passed) //A suite that failed has already said why
+    {
+        print("Unknown suite " + options.suite);
+        return 1;
+    }
+
+    if (options.csvFile != juce::File())
+        writeCsv(results, options.csvFile);
+
+    if (options.jsonFile != juce::File())
+        writeJson(results, options.jsonFile);
+
+    if (options.baselineFile != juce::File() && compareWithBaseline(results, options) > 0)
+        return 1;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    This file contains the profiler of the audio callback (Only compiled with MULTIPLUGIN_PROFILING=1).
+
+  ==============================================================================
+*/
+
+#include "CallbackProfiler.h"
+
+#if MULTIPLUGIN_PROFILING
+
+//==============================================================================
+void CallbackProfiler::prepare(double sampleRate) noexcept
+{
+    jassert(sampleRate > 0);
+
+    ticksPerSample = (double) juce::Time::getHighResolutionTicksPerSecond() / sampleRate;
+    resetRequested = true;
+}
+
+void CallbackProfiler::addBlock(juce::int64 elapsedTicks, int numSamples) noexcept
+{
+    if (resetRequested.exchange(false, std::memory_order_relaxed))
+    {
+        for (auto& bin : histogram)
+            bin.store(0, std::memory_order_relaxed);
+
+        numBlocks.store(0, std::memory_order_relaxed);
+        numOverruns.store(0, std::memory_order_relaxed);
+        totalLoad.store(0.0, std::memory_order_relaxed);
+        worstLoad.store(0.0, std::memory_order_relaxed);
+        worstSeconds.store(0.0, std::memory_order_relaxed);
+    }
+
+    if (numSamples <= 0 || ticksPerSample <= 0.0)
+        return;
+
+    const auto load = (double) elapsedTicks / (ticksPerSample * numSamples); //Fraction of the deadline of the block
+    const auto bin = juce::jmin(numBins - 1, (int) (load / binWidth));
+
+    histogram[(size_t) bin].store(histogram[(size_t) bin].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    numBlocks.store(numBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    totalLoad.store(totalLoad.load(std::memory_order_relaxed) + load, std::memory_order_relaxed);
+
+    if (load > 1.0)
+        numOverruns.store(numOverruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (load > worstLoad.load(std::memory_order_relaxed))
+    {
+        worstLoad.store(load, std::memory_order_relaxed);
+        worstSeconds.store((double) elapsedTicks * secondsPerTick, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+CallbackProfiler::Statistics CallbackProfiler::getStatistics() const noexcept
+{
+    Statistics statistics;
+
+    for (size_t bin = 0; bin < (size_t) numBins; ++bin)
+        statistics.histogram[bin] = histogram[bin].load(std::memory_order_relaxed);
+
+    statistics.numBlocks = numBlocks.load(std::memory_order_relaxed);
+    statistics.numOverruns = numOverruns.load(std::memory_order_relaxed);
+    statistics.averageLoad = statistics.numBlocks > 0 ? totalLoad.load(std::memory_order_relaxed) / (double) statistics.numBlocks : 0.0;
+    statistics.worstLoad = worstLoad.load(std::memory_order_relaxed);
+    statistics.worstMilliseconds = worstSeconds.load(std::memory_order_relaxed) * 1000.0;
+    return statistics;
+}
+
+juce::String CallbackProfiler::Statistics::toString() const
+{
+    return "average " + juce::String(averageLoad * 100.0, 2) + "% of the deadline, worst " + juce::String(worstLoad * 100.0, 1)
+         + "% (" + juce::String(worstMilliseconds, 3) + " ms), " + juce::String((juce::int64) numOverruns) + " overruns in "
+         + juce::String((juce::int64) numBlocks) + " blocks";
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    This file contains the profiler of the audio callback (Only compiled with MULTIPLUGIN_PROFILING=1).
+
+    Every processBlock is timed with the high resolution counter and compared with its deadline, the time the host
+    has to play the block (Samples / sample rate). The ratio is the load of the block: it goes into a histogram, the
+    blocks above 100% are counted as overruns and the worst block is kept. Only the audio thread writes the counters
+    (Relaxed atomics, two reads of the counter per block), the editor and the log read them from the message thread
+    and ask the audio thread to clear them.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MULTIPLUGIN_PROFILING
+ #define MULTIPLUGIN_PROFILING 0
+#endif
+
+#if MULTIPLUGIN_PROFILING
+
+//==============================================================================
+class CallbackProfiler
+{
+public:
+    static constexpr int numBins = 40; //Bins of the histogram
+    static constexpr double binWidth = 0.05; //Load covered by a bin (5% of the deadline, the last bin also counts everything above 200%)
+
+    struct Statistics //Copy of the counters for the message thread
+    {
+        std::array<juce::uint32, numBins> histogram {}; //Blocks in every bin
+        juce::uint64 numBlocks = 0, numOverruns = 0; //Blocks timed and blocks that took longer than their deadline
+        double averageLoad = 0.0, worstLoad = 0.0; //Fractions of the deadline
+        double worstMilliseconds = 0.0; //Time of the worst block
+
+        juce::String toString() const; //One line summary for the log
+    };
+
+    //==============================================================================
+    void prepare(double sampleRate) noexcept; //Sets the deadline of a sample and clears the counters (Audio stopped)
+    void reset() noexcept { resetRequested = true; } //Any thread, the counters are cleared by the audio thread on the next block
+
+    Statistics getStatistics() const noexcept;
+
+    //Times the block from its construction to the end of the scope (Audio thread)
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(CallbackProfiler& profilerToUse, int numSamplesInBlock) noexcept
+            : profiler(profilerToUse), numSamples(numSamplesInBlock), startTicks(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedBlock() noexcept { profiler.addBlock(juce::Time::getHighResolutionTicks() - startTicks, numSamples); }
+
+    private:
+        CallbackProfiler& profiler;
+        const int numSamples;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBlock)
+    };
+
+private:
+    void addBlock(juce::int64 elapsedTicks, int numSamples) noexcept;
+
+    std::array<std::atomic<juce::uint32>, numBins> histogram {};
+    std::atomic<juce::uint64> numBlocks { 0 }, numOverruns { 0 };
+    std::atomic<double> totalLoad { 0.0 }, worstLoad { 0.0 }, worstSeconds { 0.0 }; //Only written by the audio thread, so a load and a store are enough
+    std::atomic<bool> resetRequested { false };
+
+    double ticksPerSample = 0.0; //High resolution ticks in one sample at the rate of the host (The deadline of a block is numSamples times this)
+    double secondsPerTick = 1.0 / (double) juce::Time::getHighResolutionTicksPerSecond();
+};
+
+#endif
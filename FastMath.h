@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    This file contains the fast approximations of tan(), exp2(), log2() and the dB conversions used by the filters,
+    the compressors, the gain and the modulation of the plugin.
+
+    exp2() splits its argument into an integer, written straight into the exponent bits, and a fraction between -0.5
+    and 0.5 that goes through the Taylor series of 2^x. log2() reads the exponent from the bits and runs the series of
+    atanh() on the mantissa, moved between sqrt(0.5) and sqrt(2) so the series converges fast. tan() is a convergent
+    of the continued fraction of Lambert up to pi/4, and 1 / tan(pi/2 - x) above it. The float versions use shorter
+    series than the double ones, each is as long as its precision needs and no longer.
+
+    Every function has no branch and no table, so a loop over a block of values (Or over the lanes of SIMD registers)
+    is vectorised by the compiler; the block versions are those loops. juce::dsp::SIMDRegister has no cast between
+    the bits of floating point and integer lanes, so there is no register version.
+
+    The largest relative errors are in maximumError(), the fastMath suite of the benchmark checks them against the
+    std:: functions and times both.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+namespace FastMath
+{
+    enum class Function { tan, exp2, log2, decibelsToGain, gainToDecibels };
+
+    //Largest relative error of a function over its whole domain
+    template <typename SampleType>
+    constexpr double maximumError(Function function) noexcept
+    {
+        constexpr auto isFloat = std::is_same_v<SampleType, float>;
+
+        switch (function)
+        {
+        case Function::tan:            return isFloat ? 5.0e-7 : 5.0e-15;
+        case Function::exp2:           return isFloat ? 5.0e-7 : 5.0e-15;
+        case Function::log2:           return isFloat ? 5.0e-7 : 5.0e-15;
+        case Function::decibelsToGain: return isFloat ? 5.0e-6 : 2.5e-13; //The product with log2(10) / 20 rounds more on the large arguments
+        case Function::gainToDecibels: return isFloat ? 5.0e-7 : 5.0e-15;
+        default:                       return 0.0;
+        }
+    }
+
+    namespace Detail
+    {
+        template <typename SampleType> struct Bits;
+
+        template <> struct Bits<float>
+        {
+            using Integer = int32_t;
+            static constexpr int mantissaBits = 23, exponentBias = 127;
+            static constexpr Integer mantissaMask = 0x007fffff, sqrtHalf = 0x3f3504f3; //sqrt(0.5)
+        };
+
+        template <> struct Bits<double>
+        {
+            using Integer = int64_t;
+            static constexpr int mantissaBits = 52, exponentBias = 1023;
+            static constexpr Integer mantissaMask = 0x000fffffffffffff, sqrtHalf = 0x3fe6a09e667f3bcd;
+        };
+
+        template <typename To, typename From>
+        inline To bitCast(From value) noexcept //std::bit_cast of C++20
+        {
+            static_assert(sizeof(To) == sizeof(From));
+            To result;
+            std::memcpy(&result, &value, sizeof(To));
+            return result;
+        }
+
+        //condition ? a : b. In float it is done on the bits, GCC keeps a branch for ?: on floating point values and does not
+        //vectorise the loop. Without AVX-512 there is no conversion between double and 64 bit integer lanes, so the double
+        //versions run one value at a time anyway, and the masks would only add moves between the registers.
+        template <typename SampleType>
+        inline SampleType select(bool condition, SampleType a, SampleType b) noexcept
+        {
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                const auto mask = -static_cast<int32_t>(condition);
+                return bitCast<float>((bitCast<int32_t>(a) & mask) | (bitCast<int32_t>(b) & ~mask));
+            }
+            else
+            {
+                return condition ? a : b;
+            }
+        }
+    }
+
+    //==============================================================================
+    //2^x (Limited to the range of the normal numbers, -126 to 127 in float)
+    template <typename SampleType>
+    inline SampleType exp2(SampleType x) noexcept
+    {
+        using B = Detail::Bits<SampleType>;
+        using Integer = typename B::Integer;
+
+        x = Detail::select(x < SampleType(1 - B::exponentBias), SampleType(1 - B::exponentBias), x);
+        x = Detail::select(x > SampleType(B::exponentBias), SampleType(B::exponentBias), x);
+
+        const auto rounded = x + SampleType(0.5); //Nearest integer (Truncated, then one down for the negative ones)
+        auto n = static_cast<Integer>(rounded);
+        n -= static_cast<Integer>(rounded < static_cast<SampleType>(n));
+        const auto f = x - static_cast<SampleType>(n); //-0.5 to 0.5
+
+        SampleType p; //2^f, ln(2)^k / k!
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            p = 1.0f + f * (0.693147182f + f * (0.240226507f + f * (0.0555041087f + f * (0.00961812911f
+                     + f * (0.00133335581f + f * 0.000154035304f)))));
+        }
+        else //In powers of f^2 (Estrin), the 12 terms are not one long chain of dependent operations
+        {
+            const auto f2 = f * f, f4 = f2 * f2, f8 = f4 * f4;
+            p = (1.0 + 0.6931471805599453 * f) + (0.2402265069591007 + 0.055504108664821576 * f) * f2
+                + ((0.009618129107628477 + 0.0013333558146428441 * f) + (0.00015403530393381606 + 1.5252733804059838e-05 * f) * f2) * f4
+                + ((1.3215486790144305e-06 + 1.0178086009239696e-07 * f) + (7.054911620801121e-09 + 4.44553827187081e-10 * f) * f2 + 2.5678435993488196e-11 * f4) * f8;
+        }
+
+        return p * Detail::bitCast<SampleType>(static_cast<Integer>(n + B::exponentBias) << B::mantissaBits);
+    }
+
+    //log2(x) for a positive normal x
+    template <typename SampleType>
+    inline SampleType log2(SampleType x) noexcept
+    {
+        using B = Detail::Bits<SampleType>;
+        using Integer = typename B::Integer;
+
+        //x = 2^e * m with m from sqrt(0.5) to sqrt(2), read from the bits without a branch
+        const auto offset = Detail::bitCast<Integer>(x) - B::sqrtHalf;
+        const auto e = static_cast<SampleType>(offset >> B::mantissaBits);
+        const auto m = Detail::bitCast<SampleType>(static_cast<Integer>((offset & B::mantissaMask) + B::sqrtHalf));
+
+        //log2(m) = 2 / ln(2) * atanh(t), t = (m - 1) / (m + 1) stays under 0.172
+        const auto t = (m - SampleType(1)) / (m + SampleType(1));
+        const auto t2 = t * t;
+        SampleType p; //2 / ((2k + 1) ln(2))
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            p = 2.88539004f + t2 * (0.961796701f + t2 * (0.577078044f + t2 * (0.412198573f + t2 * 0.320598900f)));
+        }
+        else //Estrin like exp2()
+        {
+            const auto t4 = t2 * t2, t8 = t4 * t4, t16 = t8 * t8;
+            p = (2.8853900817779268 + 0.9617966939259757 * t2) + (0.5770780163555853 + 0.41219858311113244 * t2) * t4
+                + ((0.3205988979753252 + 0.2623081892525388 * t2) + (0.2219530832136867 + 0.19235933878519512 * t2) * t4) * t8
+                + (0.16972882833987804 + 0.15186263588304877 * t2) * t16;
+        }
+
+        return e + t * p;
+    }
+
+    //tan(x) for x from -pi/2 to pi/2 (The prewarping of the cutoff of a filter, pi * frequency / rate)
+    template <typename SampleType>
+    inline SampleType tan(SampleType x) noexcept
+    {
+        //pi/2 in two parts: halfPi - a is exact above pi/4, so pi/2 - a keeps its precision close to pi/2
+        constexpr auto isFloat = std::is_same_v<SampleType, float>;
+        constexpr auto halfPi = static_cast<SampleType>(1.5707963267948966);
+        constexpr auto halfPiRest = static_cast<SampleType>(isFloat ? -4.3711390001862426e-08 : 6.123233995736766e-17); //pi/2 - halfPi
+
+        const auto a = std::abs(x);
+        const auto isReflected = a > halfPi * SampleType(0.5); //tan(a) = 1 / tan(pi/2 - a)
+        const auto r = Detail::select(isReflected, (halfPi - a) + halfPiRest, a);
+        const auto r2 = r * r;
+        SampleType numerator, denominator; //tan(r) = numerator / denominator
+
+        if constexpr (isFloat)
+        {
+            numerator = r * (945.0f + r2 * (-105.0f + r2));
+            denominator = 945.0f + r2 * (-420.0f + r2 * 15.0f);
+        }
+        else
+        {
+            numerator = r * (2027025.0 + r2 * (-270270.0 + r2 * (6930.0 + r2 * -36.0)));
+            denominator = 2027025.0 + r2 * (-945945.0 + r2 * (51975.0 + r2 * (-630.0 + r2)));
+        }
+
+        const auto result = Detail::select(isReflected, denominator, numerator) / Detail::select(isReflected, numerator, denominator);
+        return Detail::select(x < SampleType(0), -result, result);
+    }
+
+    //e^x (Through exp2(), the error grows with the argument like the one of the product x * log2(e))
+    template <typename SampleType>
+    inline SampleType exp(SampleType x) noexcept
+    {
+        return FastMath::exp2(x * SampleType(1.4426950408889634));
+    }
+
+    //Same as juce::Decibels::decibelsToGain(), 0 at or under minusInfinitydB
+    template <typename SampleType>
+    inline SampleType decibelsToGain(SampleType decibels, SampleType minusInfinitydB = SampleType(-100)) noexcept
+    {
+        const auto gain = FastMath::exp2(decibels * SampleType(0.1660964047443681)); //log2(10) / 20
+        return Detail::select(decibels > minusInfinitydB, gain, SampleType(0));
+    }
+
+    //Same as juce::Decibels::gainToDecibels(), minusInfinitydB at 0
+    template <typename SampleType>
+    inline SampleType gainToDecibels(SampleType gain, SampleType minusInfinitydB = SampleType(-100)) noexcept
+    {
+        const auto smallest = std::numeric_limits<SampleType>::min(); //Smallest normal number, 0 and the negative gains read as minusInfinitydB
+        const auto decibels = FastMath::log2(Detail::select(gain > smallest, gain, smallest)) * SampleType(6.020599913279624); //20 log10(2)
+        return Detail::select(decibels > minusInfinitydB, decibels, minusInfinitydB);
+    }
+
+    //==============================================================================
+    //Block versions (destination can be the source)
+    template <typename SampleType>
+    inline void exp2(SampleType* destination, const SampleType* source, int numValues) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+            destination[i] = FastMath::exp2(source[i]);
+    }
+
+    template <typename SampleType>
+    inline void log2(SampleType* destination, const SampleType* source, int numValues) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+            destination[i] = FastMath::log2(source[i]);
+    }
+
+    template <typename SampleType>
+    inline void decibelsToGain(SampleType* destination, const SampleType* source, int numValues, SampleType minusInfinitydB = SampleType(-100)) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+            destination[i] = FastMath::decibelsToGain(source[i], minusInfinitydB);
+    }
+
+    template <typename SampleType>
+    inline void gainToDecibels(SampleType* destination, const SampleType* source, int numValues, SampleType minusInfinitydB = SampleType(-100)) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+            destination[i] = FastMath::gainToDecibels(source[i], minusInfinitydB);
+    }
+}
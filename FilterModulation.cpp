@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+    This file contains the modulation of the filter of the plugin (An LFO and an envelope follower).
+
+    The follower is a one pole filter with an attack and a release like the envelope of the compressor, but it moves
+    once per chunk: a chunk of n samples moves it by exp(-n / (time * rate)), the same as n steps of one sample. The
+    coefficients are kept for two chunk lengths, the control rate and the shorter last chunk of a block, so exp() only
+    runs when the size of the blocks of the host or a time changes.
+
+  ==============================================================================
+*/
+
+#include "FilterModulation.h"
+#include "PluginParameters.h"
+#include "FastMath.h"
+
+//==============================================================================
+template <typename SampleType>
+void FilterModulation<SampleType>::prepare(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+
+    sampleRate = newSampleRate;
+    setEnvelopeAttack(attackTime);
+    setEnvelopeRelease(releaseTime);
+    updateLfoIncrement();
+    reset();
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::reset() noexcept
+{
+    phase = 0.0;
+    envelope = 0;
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setLfoShape(int newShape) noexcept
+{
+    shape = newShape;
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setLfoRate(SampleType newRateHz) noexcept
+{
+    jassert(newRateHz > static_cast<SampleType>(0));
+
+    rateHz = newRateHz;
+    updateLfoIncrement();
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setLfoSync(bool shouldSync) noexcept
+{
+    sync = shouldSync;
+    updateLfoIncrement();
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setLfoBeats(double newBeatsPerCycle) noexcept
+{
+    jassert(newBeatsPerCycle > 0.0);
+
+    beatsPerCycle = newBeatsPerCycle;
+    updateLfoIncrement();
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setLfoDepths(SampleType newCutoffOctaves, SampleType newResonance) noexcept
+{
+    lfoCutoff = newCutoffOctaves;
+    lfoResonance = newResonance;
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setEnvelopeAttack(SampleType newAttackMs) noexcept
+{
+    jassert(newAttackMs > static_cast<SampleType>(0));
+
+    attackTime = newAttackMs;
+    attackInverse = static_cast<SampleType>(1000.0 / ((double) attackTime * sampleRate));
+    clearChunkCoefficients(); //The next chunks recompute them
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setEnvelopeRelease(SampleType newReleaseMs) noexcept
+{
+    jassert(newReleaseMs > static_cast<SampleType>(0));
+
+    releaseTime = newReleaseMs;
+    releaseInverse = static_cast<SampleType>(1000.0 / ((double) releaseTime * sampleRate));
+    clearChunkCoefficients();
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setEnvelopeDepths(SampleType newCutoffOctaves, SampleType newResonance) noexcept
+{
+    envelopeCutoff = newCutoffOctaves;
+    envelopeResonance = newResonance;
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::setTempo(double newBpm, double ppqPosition, bool isPlaying) noexcept
+{
+    if (newBpm > 0.0 && newBpm != bpm)
+    {
+        bpm = newBpm;
+        updateLfoIncrement();
+    }
+
+    if (sync && isPlaying) //Locked to the position of the host (When it is stopped, the LFO keeps running at the tempo)
+    {
+        const auto cycles = ppqPosition / beatsPerCycle;
+        phase = cycles - std::floor(cycles); //The position is negative during a pre-roll
+    }
+}
+
+template <typename SampleType>
+bool FilterModulation<SampleType>::isActive() const noexcept
+{
+    const auto zero = static_cast<SampleType>(0);
+    return lfoCutoff != zero || lfoResonance != zero || envelopeCutoff != zero || envelopeResonance != zero;
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::updateLfoIncrement() noexcept
+{
+    phaseIncrement = sync ? bpm / (60.0 * beatsPerCycle * sampleRate) : (double) rateHz / sampleRate;
+}
+
+//==============================================================================
+template <typename SampleType>
+SampleType FilterModulation<SampleType>::getLfoValue() const noexcept
+{
+    switch (shape)
+    {
+    case LfoShapes::triangle: //Starts at -1 like the saw, so a synced sweep starts at the bottom on the bar
+        return static_cast<SampleType>(1.0 - 4.0 * std::abs(phase - 0.5));
+    case LfoShapes::saw: //Rising
+        return static_cast<SampleType>(2.0 * phase - 1.0);
+    case LfoShapes::square:
+        return static_cast<SampleType>(phase < 0.5 ? 1.0 : -1.0);
+    case LfoShapes::sine:
+    default:
+        return static_cast<SampleType>(std::sin(juce::MathConstants<double>::twoPi * phase));
+    }
+}
+
+template <typename SampleType>
+typename FilterModulation<SampleType>::Values FilterModulation<SampleType>::advance(const juce::dsp::AudioBlock<const SampleType>& chunk) noexcept
+{
+    const auto numSamples = (double) chunk.getNumSamples();
+    const auto zero = static_cast<SampleType>(0);
+
+    //LFO (Moves by the whole chunk at once, the value is the one at the end of it)
+    phase += phaseIncrement * numSamples;
+    phase -= std::floor(phase);
+    const auto lfo = lfoCutoff != zero || lfoResonance != zero ? getLfoValue() : zero;
+
+    //Follower (Only reads the chunk when it has a depth)
+    if (envelopeCutoff != zero || envelopeResonance != zero)
+    {
+        const auto range = chunk.findMinAndMax();
+        const auto peak = juce::jmax(-range.getStart(), range.getEnd());
+        const auto level = juce::jlimit(zero, SampleType(1), SampleType(1) - FastMath::gainToDecibels(peak, SampleType(followerFloordB)) / SampleType(followerFloordB));
+        const auto& coefficients = getChunkCoefficients(chunk.getNumSamples());
+        const auto coefficient = level > envelope ? coefficients.attack : coefficients.release;
+
+        envelope = level + coefficient * (envelope - level);
+    }
+    else
+    {
+        envelope = zero; //Starts from silence when a depth is set again
+    }
+
+    return { lfo * lfoCutoff + envelope * envelopeCutoff, lfo * lfoResonance + envelope * envelopeResonance };
+}
+
+template <typename SampleType>
+void FilterModulation<SampleType>::clearChunkCoefficients() noexcept
+{
+    for (auto& coefficients : chunkCoefficients)
+        coefficients.numSamples = 0;
+}
+
+template <typename SampleType>
+const typename FilterModulation<SampleType>::ChunkCoefficients& FilterModulation<SampleType>::getChunkCoefficients(size_t numSamples) noexcept
+{
+    for (size_t i = 0; i < chunkCoefficients.size(); ++i)
+    {
+        if (chunkCoefficients[i].numSamples == numSamples)
+        {
+            lastChunkCoefficients = i;
+            return chunkCoefficients[i];
+        }
+    }
+
+    //Not cached, the entry that was not used last is replaced (The lengths of the chunks of a block take turns, so both stay cached)
+    lastChunkCoefficients = 1 - lastChunkCoefficients;
+    auto& coefficients = chunkCoefficients[lastChunkCoefficients];
+    coefficients.numSamples = numSamples;
+    coefficients.attack = std::exp(-static_cast<SampleType>(numSamples) * attackInverse);
+    coefficients.release = std::exp(-static_cast<SampleType>(numSamples) * releaseInverse);
+    return coefficients;
+}
+
+//==============================================================================
+template class FilterModulation<float>;
+template class FilterModulation<double>;
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    This file contains the modulation of the filter of the plugin (An LFO and an envelope follower).
+
+    The modulation runs at a control rate: the engine cuts the block into chunks of a few samples, the LFO and the
+    follower move over every chunk at once and the engine sets the filter to the modulated cutoff and resonance at
+    the end of it. The filters ramp their coefficients over the chunk, so the sweep is smooth while tan() and exp()
+    only run once per chunk instead of once per sample.
+
+    The LFO runs free at its own rate in Hz, or synced to the tempo of the host with a length in beats. While the
+    host is playing, the synced LFO takes its phase from the position of the host at every block, so it stays locked
+    to the bars after a jump of the transport. The follower reads the peak of every chunk of the filter input and
+    maps it from -60 to 0 dB to the 0 to 1 range of the depths.
+
+    The depths move the cutoff in octaves and the resonance in its own units. The LFO moves both ways around the
+    values of the parameters, the follower only in the direction of its depths.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+template <typename SampleType>
+class FilterModulation
+{
+public:
+    struct Values //Modulation at the end of a chunk
+    {
+        SampleType cutoffOctaves = 0, resonance = 0;
+    };
+
+    static constexpr double followerFloordB = -60.0; //Level the follower reads as 0 (0 dB reads as 1)
+
+    //==============================================================================
+    void prepare(double newSampleRate) noexcept; //Sets the rate of the host (Nothing is allocated)
+    void reset() noexcept; //Starts the LFO at its beginning and the follower from silence
+
+    void setLfoShape(int newShape) noexcept; //Sine, Triangle, Saw or Square (Choice indexes of the filterLfoShape parameter)
+    void setLfoRate(SampleType newRateHz) noexcept; //Rate of the free running LFO
+    void setLfoSync(bool shouldSync) noexcept; //Follows the tempo of the host instead of the rate
+    void setLfoBeats(double newBeatsPerCycle) noexcept; //Length of a cycle in beats when synced (Quarter notes)
+    void setLfoDepths(SampleType newCutoffOctaves, SampleType newResonance) noexcept; //Depths of the LFO (Both ways)
+    void setEnvelopeAttack(SampleType newAttackMs) noexcept; //Attack of the follower in ms
+    void setEnvelopeRelease(SampleType newReleaseMs) noexcept; //Release of the follower in ms
+    void setEnvelopeDepths(SampleType newCutoffOctaves, SampleType newResonance) noexcept; //Depths of the follower at 0 dB
+    void setTempo(double newBpm, double ppqPosition, bool isPlaying) noexcept; //Tempo and position of the host at the start of the block (Only the synced LFO uses them)
+
+    bool isActive() const noexcept; //False when every depth is 0, the engine then skips the modulation
+
+    //==============================================================================
+    Values advance(const juce::dsp::AudioBlock<const SampleType>& chunk) noexcept; //Moves the LFO and the follower over a chunk of the filter input
+
+private:
+    struct ChunkCoefficients //Coefficients of the follower for a chunk of numSamples samples, exp(-numSamples * inverse)
+    {
+        size_t numSamples = 0; //0 when a time changed
+        SampleType attack = 0, release = 0;
+    };
+
+    SampleType getLfoValue() const noexcept; //-1 to 1 at the current phase
+    const ChunkCoefficients& getChunkCoefficients(size_t numSamples) noexcept; //Cached coefficients of a chunk length (exp() only runs for a new length)
+    void clearChunkCoefficients() noexcept;
+    void updateLfoIncrement() noexcept;
+
+    //==============================================================================
+    int shape = 0;
+    SampleType rateHz = 1;
+    double beatsPerCycle = 1.0, bpm = 120.0;
+    bool sync = false;
+    double phase = 0.0, phaseIncrement = 0.0; //Phase from 0 to 1 and its increment per sample
+    SampleType lfoCutoff = 0, lfoResonance = 0, envelopeCutoff = 0, envelopeResonance = 0;
+    SampleType attackTime = 10, releaseTime = 100; //ms
+    SampleType attackInverse = 0, releaseInverse = 0; //1 / (time * rate), the coefficient of a chunk is exp(-numSamples * inverse)
+    std::array<ChunkCoefficients, 2> chunkCoefficients {}; //For the control rate and for the last chunk of a block
+    size_t lastChunkCoefficients = 0; //Entry used by the last chunk
+    SampleType envelope = 0; //0 to 1
+    double sampleRate = 44100.0;
+};
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    This file contains the level meters of the editor (Input, output and gain reduction of the compressor).
+
+  ==============================================================================
+*/
+
+#include "LevelMeter.h"
+
+//==============================================================================
+LevelMeter::LevelMeter(MeterFifo& fifoToUse)
+    : fifo(fifoToUse)
+{
+    setInterceptsMouseClicks(false, false); //The meters only display levels
+    lastUpdateTime = juce::Time::getMillisecondCounterHiRes() * 0.001;
+}
+
+//==============================================================================
+void LevelMeter::update()
+{
+    const auto now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    const auto elapsedSeconds = (float) juce::jlimit(0.0, 0.1, now - lastUpdateTime); //Limited so a stalled message thread does not empty the bars at once
+    lastUpdateTime = now;
+
+    //Every frame since the last vblank is merged: the loudest peaks, the latest RMS and the largest gain reduction
+    float inputPeak = 0.0f, inputRms = 0.0f, outputPeak = 0.0f, outputRms = 0.0f, compressorGain = 1.0f;
+
+    const auto numFrames = fifo.pop([&](const MeterFrame& frame)
+    {
+        inputPeak = juce::jmax(inputPeak, frame.inputPeak);
+        outputPeak = juce::jmax(outputPeak, frame.outputPeak);
+        inputRms = frame.inputRms;
+        outputRms = frame.outputRms;
+        compressorGain = juce::jmin(compressorGain, frame.compressorGain);
+    });
+
+    if (numFrames == 0 && input.peak <= minimumdB && output.peak <= minimumdB && input.heldPeak <= minimumdB && output.heldPeak <= minimumdB && gainReductiondB <= 0.0f)
+        return; //Nothing new and nothing left to fall (The held peaks fall after the bars), so there is nothing to repaint
+
+    const auto toDecibels = [](float gain) { return juce::Decibels::gainToDecibels(gain, minimumdB); };
+    applyBallistics(input, toDecibels(inputPeak), toDecibels(inputRms), elapsedSeconds);
+    applyBallistics(output, toDecibels(outputPeak), toDecibels(outputRms), elapsedSeconds);
+
+    const auto newGainReductiondB = -juce::Decibels::gainToDecibels(compressorGain, minimumdB);
+    gainReductiondB = newGainReductiondB >= gainReductiondB ? newGainReductiondB //The gain reduction rises at once and falls back like the bars
+                                                            : juce::jmax(newGainReductiondB, gainReductiondB - fallRatedB * elapsedSeconds);
+
+    repaint();
+}
+
+void LevelMeter::applyBallistics(Level& level, float newPeakdB, float newRmsdB, float elapsedSeconds) noexcept
+{
+    const auto fall = fallRatedB * elapsedSeconds;
+    level.peak = juce::jmax(newPeakdB, level.peak - fall, minimumdB);
+    level.rms = juce::jmax(newRmsdB, level.rms - fall, minimumdB);
+
+    level.holdTime += elapsedSeconds;
+
+    if (level.peak >= level.heldPeak)
+    {
+        level.heldPeak = level.peak;
+        level.holdTime = 0.0;
+    }
+    else if (level.holdTime > peakHoldSeconds)
+    {
+        level.heldPeak = juce::jmax(level.peak, level.heldPeak - fall); //Falls once the hold time is over
+    }
+}
+
+//==============================================================================
+float LevelMeter::dBToProportion(float levelInDecibels) const noexcept
+{
+    return juce::jlimit(0.0f, 1.0f, (levelInDecibels - minimumdB) / -minimumdB);
+}
+
+void LevelMeter::drawBar(juce::Graphics& g, juce::Rectangle<float> area, const Level& level, juce::Colour colour, const juce::String& name) const
+{
+    const auto labelArea = area.removeFromBottom(16.0f);
+
+    g.setColour(juce::Colour(0xdd111111)); //Backround
+    g.fillRect(area);
+
+    auto peakArea = area;
+    g.setColour(colour.withAlpha(0.45f)); //Peak
+    g.fillRect(peakArea.removeFromBottom(area.getHeight() * dBToProportion(level.peak)));
+
+    auto rmsArea = area;
+    g.setColour(colour); //RMS
+    g.fillRect(rmsArea.removeFromBottom(area.getHeight() * dBToProportion(level.rms)));
+
+    if (level.heldPeak > minimumdB) //Held Peak
+    {
+        const auto y = area.getBottom() - area.getHeight() * dBToProportion(level.heldPeak);
+        g.setColour(level.heldPeak > -0.1f ? juce::Colour(0xffff3252) : juce::Colour(0xffff88ff)); //Red when the level reaches 0 dB
+        g.fillRect(area.getX(), y - 1.0f, area.getWidth(), 2.0f);
+    }
+
+    g.setColour(juce::Colour(0xffff88ff)); //Name
+    g.setFont(11.0f);
+    g.drawText(name, labelArea, juce::Justification::centred);
+}
+
+void LevelMeter::paint(juce::Graphics& g)
+{
+    auto area = getLocalBounds().toFloat().reduced(2.0f);
+    const auto barWidth = area.getWidth() / 3.0f;
+
+    drawBar(g, area.removeFromLeft(barWidth).reduced(2.0f, 0.0f), input, juce::Colour(0xff7252ff), "In"); //Input
+    drawBar(g, area.removeFromLeft(barWidth).reduced(2.0f, 0.0f), output, juce::Colour(0xffdd00ff), "Out"); //Output
+
+    //Gain Reduction (Drawn down from the top, over the same range as the levels)
+    auto gainReductionArea = area.reduced(2.0f, 0.0f);
+    const auto labelArea = gainReductionArea.removeFromBottom(16.0f);
+    g.setColour(juce::Colour(0xdd111111));
+    g.fillRect(gainReductionArea);
+    g.setColour(juce::Colour(0xff32ff52));
+    g.fillRect(gainReductionArea.removeFromTop(gainReductionArea.getHeight() * juce::jlimit(0.0f, 1.0f, gainReductiondB / -minimumdB)));
+    g.setColour(juce::Colour(0xffff88ff));
+    g.setFont(11.0f);
+    g.drawText("GR", labelArea, juce::Justification::centred);
+}
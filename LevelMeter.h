@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    This file contains the level meters of the editor (Input, output and gain reduction of the compressor).
+
+    The meters read the frames that the audio thread wrote into the MeterFifo of the processor on every vblank of the
+    display, so they repaint in sync with the screen and never more often than it refreshes. The audio thread only
+    writes the levels, the ballistics (Fall of the bars and hold of the peaks) run here on the message thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MeterFifo.h"
+
+//==============================================================================
+class LevelMeter  : public juce::Component
+{
+public:
+    explicit LevelMeter(MeterFifo& fifoToUse);
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    void update(); //Reads the frames that are ready and applies the ballistics (Called on every vblank)
+
+    struct Level //Displayed level of one bar, in dB
+    {
+        float peak = minimumdB, rms = minimumdB, heldPeak = minimumdB;
+        double holdTime = 0.0; //Seconds since the held peak was set
+    };
+
+    void applyBallistics(Level& level, float newPeakdB, float newRmsdB, float elapsedSeconds) noexcept;
+    void drawBar(juce::Graphics& g, juce::Rectangle<float> area, const Level& level, juce::Colour colour, const juce::String& name) const;
+    float dBToProportion(float levelInDecibels) const noexcept; //Height of a level in the bar (0 at the bottom)
+
+    static constexpr float minimumdB = -60.0f; //Bottom of the meters
+    static constexpr float fallRatedB = 24.0f; //dB per second the bars fall at once the level drops
+    static constexpr double peakHoldSeconds = 1.5; //Time the peak marker stays before it falls
+
+    MeterFifo& fifo;
+    Level input, output; //Input and output bars
+    float gainReductiondB = 0.0f; //Gain reduction bar (Positive dB, drawn from the top)
+    double lastUpdateTime = 0.0; //Time of the last vblank, in seconds
+
+    juce::VBlankAttachment vBlankAttachment { this, [this] { update(); } }; //Declared last so it is detached before the levels are deleted
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeter)
+};
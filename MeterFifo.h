@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    This file contains the FIFO that carries the levels of the meters from the audio thread to the editor.
+
+    The audio thread writes one frame per block and the editor reads every frame that is ready on each vblank. It is
+    a juce::AbstractFifo over a fixed array, so both sides only use two atomic positions: writing never blocks,
+    allocates or waits for the editor, and a frame is dropped when the editor is not reading (e.g. it is closed).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+struct MeterFrame //Levels of one block
+{
+    float inputPeak = 0.0f, inputRms = 0.0f; //Main input (Linear, loudest channel for the peak and every channel for the RMS)
+    float outputPeak = 0.0f, outputRms = 0.0f; //Main output
+    float compressorGain = 1.0f; //Gain of the compressor at the end of the block (Linear, 1 without gain reduction)
+};
+
+//==============================================================================
+class MeterFifo
+{
+public:
+    static constexpr int capacity = 512; //Frames (About 2.7 s of 256 sample blocks at 48 kHz before the frames are dropped)
+
+    bool push(const MeterFrame& frame) noexcept //Audio thread, returns false when the frame was dropped
+    {
+        const auto scope = fifo.write(1);
+
+        if (scope.blockSize1 > 0)
+            frames[(size_t) scope.startIndex1] = frame;
+
+        return scope.blockSize1 > 0;
+    }
+
+    template <typename Function>
+    int pop(Function&& receiveFrame) noexcept //Message thread, passes every frame that is ready and returns how many there were
+    {
+        const auto scope = fifo.read(fifo.getNumReady());
+        scope.forEach([this, &receiveFrame](int index) { receiveFrame(frames[(size_t) index]); });
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+private:
+    juce::AbstractFifo fifo { capacity };
+    std::array<MeterFrame, capacity> frames {};
+};
@@ -0,0 +1,385 @@
+/*
+  ==============================================================================
+
+    This file contains the multi-channel compressor of the plugin.
+
+    The ballistics and the gain computer are the ones of juce::dsp::BallisticsFilter and juce::dsp::Compressor, so
+    the unlinked output with the peak detector and a hard knee is the one of the JUCE compressor that it replaced.
+
+    The soft knee is the quadratic curve between the uncompressed and the compressed line (Giannoulis, Massberg and
+    Reiss). Under the knee and over it the gain is the same as with the hard knee.
+
+    The gain computer runs in dB over the envelopes of the whole block, with the log2() and exp2() of FastMath. It has
+    no branch, so the compiler vectorises it, and it costs the same for a level under the threshold and over it. The
+    gains differ from the ones of juce::dsp::Compressor by the error of the approximations, about 1e-5 dB in float.
+
+  ==============================================================================
+*/
+
+#include "MultiChannelCompressor.h"
+#include "FastMath.h"
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate;
+
+    envelopes.assign(spec.numChannels, SampleType(0));
+    gains.assign(spec.maximumBlockSize, SampleType(1));
+    levels.assign((size_t) spec.maximumBlockSize * spec.numChannels, SampleType(0));
+    linkedLevels.assign(spec.maximumBlockSize, SampleType(0));
+    rmsWindow.prepare(spec.numChannels, (int) std::ceil(maximumRmsWindowMs * 0.001 * sampleRate));
+    keyHighpassStates.assign(spec.numChannels, SampleType(0));
+
+    delayBufferSize = juce::nextPowerOfTwo((int) std::ceil(maximumLookaheadMs * 0.001 * sampleRate) + 1); //Room for the longest lookahead
+    delayBufferMask = delayBufferSize - 1;
+    delayBuffer.assign((size_t) delayBufferSize * spec.numChannels, SampleType(0));
+
+    update();
+    reset();
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::reset() noexcept
+{
+    std::fill(envelopes.begin(), envelopes.end(), SampleType(0));
+    std::fill(delayBuffer.begin(), delayBuffer.end(), SampleType(0));
+    rmsWindow.reset();
+    std::fill(keyHighpassStates.begin(), keyHighpassStates.end(), SampleType(0));
+    writePosition = 0;
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setThreshold(SampleType newThresholddB) noexcept
+{
+    thresholddB = newThresholddB;
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setRatio(SampleType newRatio) noexcept
+{
+    jassert(newRatio >= SampleType(1.0));
+
+    ratio = newRatio;
+    ratioInverse = SampleType(1.0) / ratio;
+    updateKnee();
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setAttack(SampleType newAttackMs) noexcept
+{
+    attackTime = newAttackMs;
+    cteAT = calculateLimitedCte(attackTime);
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setRelease(SampleType newReleaseMs) noexcept
+{
+    releaseTime = newReleaseMs;
+    cteRL = calculateLimitedCte(releaseTime);
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setKnee(SampleType newKneedB) noexcept
+{
+    jassert(newKneedB >= 0);
+
+    kneedB = newKneedB;
+    updateKnee();
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setLinked(bool shouldBeLinked) noexcept
+{
+    const auto wasFullyLinked = isFullyLinked();
+    linked = shouldBeLinked;
+
+    if (wasFullyLinked != isFullyLinked())
+        std::fill(envelopes.begin(), envelopes.end(), SampleType(0)); //Fully linked, only the first envelope is used, so the others are old
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setLinkAmount(SampleType newLinkAmount) noexcept
+{
+    jassert(newLinkAmount >= 0 && newLinkAmount <= SampleType(1.0));
+
+    const auto wasFullyLinked = isFullyLinked();
+    linkAmount = newLinkAmount;
+
+    if (wasFullyLinked != isFullyLinked())
+        std::fill(envelopes.begin(), envelopes.end(), SampleType(0));
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setRmsDetector(bool shouldUseRms) noexcept
+{
+    if (rms != shouldUseRms)
+    {
+        rms = shouldUseRms;
+        rmsWindow.reset(); //The squares are not written while the peak is detected, so what is left in the window is old
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setRmsWindow(SampleType newWindowMs) noexcept
+{
+    jassert(newWindowMs > 0 && newWindowMs <= maximumRmsWindowMs);
+
+    rmsWindowTime = newWindowMs;
+    rmsWindow.setWindow(juce::jmax(1, (int) std::round(rmsWindowTime * 0.001 * sampleRate))); //Only adds up the squares already in the buffer again
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setLookahead(SampleType newLookaheadMs) noexcept
+{
+    jassert(newLookaheadMs >= 0 && newLookaheadMs <= maximumLookaheadMs);
+
+    lookaheadTime = newLookaheadMs;
+    const auto newLookaheadSamples = juce::jlimit(0, delayBufferMask, (int) std::round(lookaheadTime * 0.001 * sampleRate));
+
+    if (newLookaheadSamples != lookaheadSamples)
+    {
+        if (lookaheadSamples == 0) //The delay line is not written without a lookahead, so what is left in it is old
+            std::fill(delayBuffer.begin(), delayBuffer.end(), SampleType(0));
+
+        lookaheadSamples = newLookaheadSamples;
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::setKeyHighpass(SampleType newFrequencyHz) noexcept
+{
+    jassert(newFrequencyHz >= 0);
+
+    const auto wasOn = keyHighpassFrequency > 0;
+    keyHighpassFrequency = newFrequencyHz;
+
+    if (keyHighpassFrequency <= 0)
+        return;
+
+    const auto g = std::tan(juce::MathConstants<double>::pi * juce::jmin((double) keyHighpassFrequency, sampleRate * 0.49) / sampleRate);
+    keyHighpassG = static_cast<SampleType>(g / (1.0 + g));
+
+    if (! wasOn) //The highpass does not run while it is off, so what is left in it is old
+        std::fill(keyHighpassStates.begin(), keyHighpassStates.end(), SampleType(0));
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::update() noexcept //Every setter only recomputes its own coefficients, this is used after prepare()
+{
+    setThreshold(thresholddB);
+    setRatio(ratio);
+    setAttack(attackTime);
+    setRelease(releaseTime);
+    setRmsWindow(rmsWindowTime);
+    setKeyHighpass(keyHighpassFrequency);
+    lookaheadSamples = 0; //The rate changed, so the length in samples is computed again
+    setLookahead(lookaheadTime);
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::updateKnee() noexcept
+{
+    kneeCurve = kneedB > 0 ? (ratioInverse - SampleType(1.0)) / (SampleType(2.0) * kneedB) : SampleType(0);
+}
+
+template <typename SampleType>
+SampleType MultiChannelCompressor<SampleType>::calculateLimitedCte(SampleType timeMs) const noexcept
+{
+    return timeMs < static_cast<SampleType>(1.0e-3) ? 0 : static_cast<SampleType>(std::exp(expFactor / timeMs));
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::computeGains(SampleType* envelopesToGains, int numValues) const noexcept
+{
+    const auto kneeBottomdB = thresholddB - kneedB * SampleType(0.5);
+    const auto slope = ratioInverse - SampleType(1.0); //Of the line over the knee, same as the hard knee
+
+    FastMath::gainToDecibels(envelopesToGains, envelopesToGains, numValues, SampleType(-200.0));
+
+    //The limits are written with abs(), GCC keeps a branch for ?: on floating point values and would not vectorise the loop
+    for (int i = 0; i < numValues; ++i)
+    {
+        const auto overdB = envelopesToGains[i] - kneeBottomdB;
+        const auto insideKnee = SampleType(0.5) * (std::abs(overdB) - std::abs(overdB - kneedB) + kneedB); //overdB limited to 0 to kneedB
+        const auto aboveKnee = SampleType(0.5) * (overdB - kneedB + std::abs(overdB - kneedB)); //0 under the top of the knee
+        envelopesToGains[i] = kneeCurve * insideKnee * insideKnee + slope * aboveKnee;
+    }
+
+    FastMath::decibelsToGain(envelopesToGains, envelopesToGains, numValues, SampleType(-200.0));
+}
+
+template <typename SampleType>
+SampleType MultiChannelCompressor<SampleType>::getGain() const noexcept
+{
+    const auto numEnvelopes = isFullyLinked() ? juce::jmin((size_t) 1, envelopes.size()) : envelopes.size(); //Only the first envelope is used when fully linked
+    SampleType envelope = 0;
+
+    for (size_t channel = 0; channel < numEnvelopes; ++channel)
+        envelope = juce::jmax(envelope, envelopes[channel]);
+
+    computeGains(&envelope, 1);
+    return envelope;
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::applyDelayedGain(SampleType* samples, SampleType* delayLine, const SampleType* gainsToApply, int numSamples) const noexcept
+{
+    auto position = writePosition;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        delayLine[position] = samples[i];
+        samples[i] = delayLine[(position - lookaheadSamples) & delayBufferMask] * gainsToApply[i]; //The gain comes from the sample that is lookaheadSamples ahead of the delayed one
+        position = (position + 1) & delayBufferMask;
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::highpassKey(size_t channel, const SampleType* samples, SampleType* output, int numSamples) noexcept
+{
+    auto state = keyHighpassStates[channel];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto v = (samples[i] - state) * keyHighpassG;
+        const auto lowPass = v + state;
+        state = lowPass + v;
+        output[i] = samples[i] - lowPass;
+    }
+
+    keyHighpassStates[channel] = state;
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::detect(size_t channel, const SampleType* samples, SampleType* levelsOfChannel, int numSamples) noexcept
+{
+    if (keyHighpassFrequency > 0) //The key is filtered into the levels, so the samples it is read from are never written
+    {
+        highpassKey(channel, samples, levelsOfChannel, numSamples);
+        samples = levelsOfChannel;
+    }
+
+    if (! rms)
+    {
+        juce::FloatVectorOperations::abs(levelsOfChannel, samples, numSamples); //Peak
+        return;
+    }
+
+    rmsWindow.process(channel, samples, levelsOfChannel, numSamples); //Mean square over the window, O(1) per sample
+
+    for (int i = 0; i < numSamples; ++i)
+        levelsOfChannel[i] = std::sqrt(levelsOfChannel[i]);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+    process(context, context.getInputBlock()); //Keyed by itself (Every level is detected before the first gain is applied)
+}
+
+template <typename SampleType>
+void MultiChannelCompressor<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context, const juce::dsp::AudioBlock<const SampleType>& keyBlock) noexcept
+{
+    auto& block = context.getOutputBlock();
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = (int) block.getNumSamples();
+    const auto numKeyChannels = keyBlock.getNumChannels();
+
+    jassert(numChannels <= envelopes.size());
+    jassert(numSamples <= (int) gains.size());
+    jassert(numKeyChannels > 0 && (int) keyBlock.getNumSamples() >= numSamples);
+    jassert(numKeyChannels == 1 || numKeyChannels >= numChannels); //A mono key or one key channel for every channel (See isBusesLayoutSupported())
+
+    if (context.isBypassed)
+        return;
+
+    auto applyGains = [&](size_t channel) //Multiplies the channel by the gains, or the delayed channel with a lookahead
+    {
+        if (lookaheadSamples == 0)
+            juce::FloatVectorOperations::multiply(block.getChannelPointer(channel), gains.data(), numSamples);
+        else
+            applyDelayedGain(block.getChannelPointer(channel), delayBuffer.data() + channel * (size_t) delayBufferSize, gains.data(), numSamples);
+    };
+
+    //Level of every channel, and of the loudest one at every sample when the channels are linked
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        if (channel < numKeyChannels)
+            detect(channel, keyBlock.getChannelPointer(channel), getLevels(channel), numSamples);
+        else //A mono key, its level is used for every channel
+            juce::FloatVectorOperations::copy(getLevels(channel), getLevels(0), numSamples);
+    }
+
+    if (rms)
+        rmsWindow.advance(numSamples);
+
+    const auto link = linked ? linkAmount : SampleType(0);
+
+    if (link > 0)
+    {
+        juce::FloatVectorOperations::copy(linkedLevels.data(), getLevels(0), numSamples);
+
+        for (size_t channel = 1; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::max(linkedLevels.data(), linkedLevels.data(), getLevels(channel), numSamples);
+    }
+
+    if (isFullyLinked())
+    {
+        //The loudest channel drives one envelope, the gain computer runs once per sample for all channels
+        auto envelope = envelopes[0];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto level = linkedLevels[(size_t) i];
+            envelope = level + (level > envelope ? cteAT : cteRL) * (envelope - level);
+            gains[(size_t) i] = envelope;
+        }
+
+        envelopes[0] = envelope;
+        computeGains(gains.data(), numSamples);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            applyGains(channel);
+    }
+    else
+    {
+        //Every channel has its own envelope and gains (With a lookahead they are computed from the current samples, then applied to the delayed ones)
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* levelsOfChannel = getLevels(channel);
+            auto envelope = envelopes[channel];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto level = levelsOfChannel[i] + link * (linkedLevels[(size_t) i] - levelsOfChannel[i]); //Partly moved towards the loudest channel
+                envelope = level + (level > envelope ? cteAT : cteRL) * (envelope - level);
+                gains[(size_t) i] = envelope;
+            }
+
+            envelopes[channel] = envelope;
+            computeGains(gains.data(), numSamples);
+            applyGains(channel);
+        }
+    }
+
+    if (lookaheadSamples > 0)
+        writePosition = (writePosition + numSamples) & delayBufferMask;
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    for (auto& envelope : envelopes)
+        juce::dsp::util::snapToZero(envelope);
+    for (auto& state : keyHighpassStates)
+        juce::dsp::util::snapToZero(state);
+   #endif
+}
+
+//==============================================================================
+template class MultiChannelCompressor<float>;
+template class MultiChannelCompressor<double>;
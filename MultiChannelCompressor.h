@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    This file contains the multi-channel compressor of the plugin.
+
+    It has the ballistics and the gain computer of juce::dsp::Compressor, but the envelope of every channel is kept in
+    one contiguous array and every channel is processed as loops over its samples, so the cost grows linearly with the
+    number of channels. The detector follows the peak (Like the JUCE compressor) or the RMS over a sliding window (See
+    SlidingWindowRms), and the gain computer has an optional soft knee.
+
+    When the channels are linked, the level of every channel moves towards the loudest channel of every sample by the
+    link amount. Fully linked, the loudest channel drives one envelope and the gain computer runs once per sample for
+    all the channels, so the image of multichannel and ambisonic material does not move and linking costs less than
+    compressing every channel on its own.
+
+    The optional lookahead delays the audio in a ring buffer that is allocated in prepare() for the longest lookahead,
+    so the detector sees the transients before they reach the gain. Changing the lookahead never allocates.
+
+    The detector can be keyed by another signal (The sidechain bus of the host). The key is read straight from the
+    buffer of the host and only the levels are written, so it is never copied. Every channel is keyed by the key
+    channel with the same index, a mono key keys every channel. The optional highpass of the key is a one pole TPT
+    filter that writes into the level buffer too.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SlidingWindowRms.h"
+
+//==============================================================================
+template <typename SampleType>
+class MultiChannelCompressor
+{
+public:
+    //==============================================================================
+    static constexpr double maximumLookaheadMs = 10.0; //Longest lookahead, the delay buffer is sized for it
+    static constexpr double maximumRmsWindowMs = 50.0; //Longest RMS window, the squares are kept for it
+
+    //==============================================================================
+    void prepare(const juce::dsp::ProcessSpec& spec); //Allocates the envelopes, the level buffers, the RMS windows and the delay buffer
+    void reset() noexcept; //Clears the envelopes, the RMS windows and the delay buffer
+
+    void setThreshold(SampleType newThresholddB) noexcept; //Threshold in dB
+    void setRatio(SampleType newRatio) noexcept; //Ratio (1 or higher)
+    void setAttack(SampleType newAttackMs) noexcept; //Attack in ms
+    void setRelease(SampleType newReleaseMs) noexcept; //Release in ms
+    void setKnee(SampleType newKneedB) noexcept; //Width of the soft knee in dB around the threshold (0 is a hard knee)
+    void setLinked(bool shouldBeLinked) noexcept; //Moves the level of every channel towards the loudest one by the link amount
+    void setLinkAmount(SampleType newLinkAmount) noexcept; //0 to 1, at 1 every channel gets the same gain
+    void setRmsDetector(bool shouldUseRms) noexcept; //RMS over a sliding window instead of the peak
+    void setRmsWindow(SampleType newWindowMs) noexcept; //Length of the RMS window in ms (Up to maximumRmsWindowMs)
+    void setLookahead(SampleType newLookaheadMs) noexcept; //Lookahead in ms (0 to maximumLookaheadMs)
+    void setKeyHighpass(SampleType newFrequencyHz) noexcept; //Cutoff of the highpass of the signal the detector hears in Hz (0 turns it off)
+
+    int getLatencyInSamples() const noexcept { return lookaheadSamples; } //Delay added by the lookahead
+    SampleType getGain() const noexcept; //Gain of the loudest channel at the end of the last block (Used by the meters)
+
+    //==============================================================================
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept; //Compresses every channel of the block in place
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context, const juce::dsp::AudioBlock<const SampleType>& keyBlock) noexcept; //Same with the levels of the key (Read in place, same number of samples)
+
+private:
+    void update() noexcept; //Recomputes every coefficient (Used by prepare, the setters only recompute their own)
+    void updateKnee() noexcept; //Recomputes the curve of the knee (Depends on the ratio and the width)
+    bool isFullyLinked() const noexcept { return linked && linkAmount >= SampleType(1.0); }
+    SampleType calculateLimitedCte(SampleType timeMs) const noexcept; //Coefficient of the ballistics (Same as juce::dsp::BallisticsFilter)
+    void computeGains(SampleType* envelopesToGains, int numValues) const noexcept; //Gain computer, in place
+    void detect(size_t channel, const SampleType* samples, SampleType* levels, int numSamples) noexcept; //Level of every sample of one channel
+    void highpassKey(size_t channel, const SampleType* samples, SampleType* output, int numSamples) noexcept; //One pole highpass of the key of one channel
+    SampleType* getLevels(size_t channel) noexcept { return levels.data() + channel * gains.size(); }
+    void applyDelayedGain(SampleType* samples, SampleType* delayLine, const SampleType* gainsToApply, int numSamples) const noexcept; //Writes the block to the delay line and applies the gains to the delayed samples
+
+    //==============================================================================
+    SampleType thresholddB = 0, ratio = 1, attackTime = 1, releaseTime = 100; //Same defaults as juce::dsp::Compressor
+    SampleType lookaheadTime = 0, kneedB = 0, linkAmount = 1, rmsWindowTime = 10, keyHighpassFrequency = 0;
+    SampleType ratioInverse = 1, kneeCurve = 0; //Gain computer coefficients (The curve of the gain reduction inside the knee is in dB)
+    SampleType cteAT = 0, cteRL = 0; //Attack and release coefficients
+    SampleType keyHighpassG = 0; //Coefficient of the highpass of the key (g / (1 + g))
+    double sampleRate = 44100.0, expFactor = 0;
+    bool linked = false, rms = false;
+
+    std::vector<SampleType> envelopes; //One envelope per channel, next to each other (The first one is also used when fully linked)
+    std::vector<SampleType> gains; //Gain of every sample of the block for one channel, or for all of them when fully linked
+    std::vector<SampleType> levels; //Detected level of every sample of every channel (Each one is one block long)
+    std::vector<SampleType> linkedLevels; //Level of the loudest channel at every sample of the block
+    SlidingWindowRms<SampleType> rmsWindow; //Running mean square of every channel
+    std::vector<SampleType> keyHighpassStates; //Integrator of the highpass of the key of every channel
+
+    std::vector<SampleType> delayBuffer; //Delay line of every channel, next to each other (Each one is delayBufferSize samples long)
+    int delayBufferSize = 0, delayBufferMask = 0; //The size is a power of two so the positions wrap with a mask
+    int writePosition = 0, lookaheadSamples = 0;
+};
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+    This file contains the look and feel shared by every editor of the plugin.
+
+  ==============================================================================
+*/
+
+#include "MultiPluginLookAndFeel.h"
+
+//==============================================================================
+namespace
+{
+    const juce::Identifier glowingProperty { "glowing" }; //Property of a slider that is being dragged
+
+    //Geometry of juce::LookAndFeel_V4::drawRotarySlider, so the cached arc and the drawn value arc line up
+    struct KnobGeometry
+    {
+        KnobGeometry(juce::Rectangle<float> area)
+            : bounds(area.reduced(10.0f)),
+              radius(juce::jmin(bounds.getWidth(), bounds.getHeight()) * 0.5f),
+              lineWidth(juce::jmin(8.0f, radius * 0.5f)),
+              arcRadius(radius - lineWidth * 0.5f) {}
+
+        juce::Path getArc(float startAngle, float endAngle) const
+        {
+            juce::Path arc;
+            arc.addCentredArc(bounds.getCentreX(), bounds.getCentreY(), arcRadius, arcRadius, 0.0f, startAngle, endAngle, true);
+            return arc;
+        }
+
+        juce::PathStrokeType getStroke() const { return { lineWidth, juce::PathStrokeType::curved, juce::PathStrokeType::rounded }; }
+
+        juce::Rectangle<float> bounds;
+        float radius, lineWidth, arcRadius;
+    };
+}
+
+//==============================================================================
+MultiPluginLookAndFeel::MultiPluginLookAndFeel()
+{
+    //Sliders
+    setColour(juce::Slider::rotarySliderFillColourId, juce::Colour(0x8f87cefa)); //Before Knob (The filter sliders set their own)
+    setColour(juce::Slider::rotarySliderOutlineColourId, juce::Colour(0xdd111111)); //After Knob
+    setColour(juce::Slider::backgroundColourId, juce::Colour(0xdd111111)); //Background of the linear sliders
+    setColour(juce::Slider::trackColourId, juce::Colour(0x8f87cefa)); //Track of the linear sliders
+    setColour(juce::Slider::thumbColourId, juce::Colour(0xffdd00ff)); //Knob
+    setColour(juce::Slider::textBoxBackgroundColourId, juce::Colour(0x23ffffff)); //Textbox Backround
+    setColour(juce::Slider::textBoxTextColourId, juce::Colour(0xffff88ff)); //Text
+    setColour(juce::Slider::textBoxHighlightColourId, juce::Colour(0x9a8414ff)); //Text Highlight
+    setColour(juce::Slider::textBoxOutlineColourId, juce::Colour(0x9fdd00ff)); //Textbox Border
+    //Buttons
+    setColour(juce::ToggleButton::textColourId, juce::Colour(0xffff88ff)); //Text
+    setColour(juce::ToggleButton::tickColourId, juce::Colour(0xffdd00ff)); //Tick
+    setColour(juce::ToggleButton::tickDisabledColourId, juce::Colour(0x9fdd00ff)); //Tick Box
+    //Menus (The filter type menu sets its own colours)
+    setColour(juce::ComboBox::textColourId, juce::Colour(0xffff88ff)); //Text
+    setColour(juce::ComboBox::arrowColourId, juce::Colour(0xffff88ff)); //Arrow
+    setColour(juce::ComboBox::outlineColourId, juce::Colour(0xffff88ff)); //Outline
+    //Labels
+    setColour(juce::Label::textColourId, juce::Colour(0xffff88ff)); //Text
+}
+
+void MultiPluginLookAndFeel::setGlowing(juce::Slider& slider, bool shouldGlow)
+{
+    if ((bool) slider.getProperties()[glowingProperty] != shouldGlow)
+    {
+        slider.getProperties().set(glowingProperty, shouldGlow);
+        slider.repaint(); //Only the slider is repainted
+    }
+}
+
+//==============================================================================
+void MultiPluginLookAndFeel::renderImage(juce::Graphics& g, ImageType type, float width, float height, juce::Colour colour)
+{
+    const juce::Rectangle<float> area { width, height };
+
+    if (type == ImageType::knobBackground) //Arc over the whole range of the knob
+    {
+        const KnobGeometry knob { area };
+        g.setColour(colour);
+        g.strokePath(knob.getArc(rotaryStartAngle, rotaryEndAngle), knob.getStroke());
+    }
+    else //Blurred outline of the knob or of the linear slider (The blur is what makes juce::GlowEffect expensive)
+    {
+        juce::Path shape;
+
+        if (type == ImageType::knobGlow)
+        {
+            const KnobGeometry knob { area };
+            shape.addEllipse(knob.bounds.withSizeKeepingCentre(knob.radius * 2.0f, knob.radius * 2.0f));
+        }
+        else
+        {
+            shape.addRoundedRectangle(area.reduced((float) glowRadius), 3.0f);
+        }
+
+        juce::DropShadow(colour, glowRadius * 2, {}).drawForPath(g, shape);
+    }
+}
+
+const juce::Image& MultiPluginLookAndFeel::getCachedImage(ImageType type, int width, int height, float scale, juce::Colour colour)
+{
+    const auto physicalWidth = juce::roundToInt((float) width * scale), physicalHeight = juce::roundToInt((float) height * scale);
+    const auto key = std::make_tuple(type, physicalWidth, physicalHeight, colour.getARGB());
+    const auto found = cachedImages.find(key);
+
+    if (found != cachedImages.end())
+        return found->second;
+
+    if (cachedImages.size() >= maximumCachedImages)
+        cachedImages.clear();
+
+    juce::Image image(juce::Image::ARGB, juce::jmax(1, physicalWidth), juce::jmax(1, physicalHeight), true);
+    juce::Graphics imageGraphics(image);
+    imageGraphics.addTransform(juce::AffineTransform::scale(scale)); //Rendered at the resolution of the display
+    renderImage(imageGraphics, type, (float) width, (float) height, colour);
+
+    return cachedImages[key] = image;
+}
+
+void MultiPluginLookAndFeel::drawPart(juce::Graphics& g, ImageType type, juce::Rectangle<int> area, juce::Colour colour)
+{
+    if (! imageCachingEnabled) //Rendered every time, like without the cache
+    {
+        juce::Graphics::ScopedSaveState state(g);
+        g.setOrigin(area.getPosition());
+        renderImage(g, type, (float) area.getWidth(), (float) area.getHeight(), colour);
+        return;
+    }
+
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    g.drawImage(getCachedImage(type, area.getWidth(), area.getHeight(), scale, colour), area.toFloat());
+}
+
+//==============================================================================
+void MultiPluginLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos,
+                                              float startAngle, float endAngle, juce::Slider& slider)
+{
+    const juce::Rectangle<int> area { x, y, width, height };
+    const KnobGeometry knob { area.toFloat() };
+
+    if ((bool) slider.getProperties()[glowingProperty]) //Glow
+        drawPart(g, ImageType::knobGlow, area, juce::Colour(0x1fff88ff));
+
+    //Background arc from the cache (The editors keep the default angles, other angles are drawn like LookAndFeel_V4)
+    if (juce::approximatelyEqual(startAngle, rotaryStartAngle) && juce::approximatelyEqual(endAngle, rotaryEndAngle))
+    {
+        drawPart(g, ImageType::knobBackground, area, slider.findColour(juce::Slider::rotarySliderOutlineColourId));
+    }
+    else
+    {
+        g.setColour(slider.findColour(juce::Slider::rotarySliderOutlineColourId));
+        g.strokePath(knob.getArc(startAngle, endAngle), knob.getStroke());
+    }
+
+    //Value arc and knob (They move with the value, so they are drawn every time)
+    const auto toAngle = startAngle + sliderPos * (endAngle - startAngle);
+
+    if (slider.isEnabled())
+    {
+        g.setColour(slider.findColour(juce::Slider::rotarySliderFillColourId));
+        g.strokePath(knob.getArc(startAngle, toAngle), knob.getStroke());
+    }
+
+    const auto thumbWidth = knob.lineWidth * 2.0f;
+    const juce::Point<float> thumbPoint { knob.bounds.getCentreX() + knob.arcRadius * std::cos(toAngle - juce::MathConstants<float>::halfPi),
+                                          knob.bounds.getCentreY() + knob.arcRadius * std::sin(toAngle - juce::MathConstants<float>::halfPi) };
+    g.setColour(slider.findColour(juce::Slider::thumbColourId));
+    g.fillEllipse(juce::Rectangle<float>(thumbWidth, thumbWidth).withCentre(thumbPoint));
+}
+
+void MultiPluginLookAndFeel::drawLinearSlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float minSliderPos,
+                                              float maxSliderPos, juce::Slider::SliderStyle style, juce::Slider& slider)
+{
+    if ((bool) slider.getProperties()[glowingProperty]) //Glow
+        drawPart(g, ImageType::linearGlow, { x, y, width, height }, juce::Colour(0x1fff88ff));
+
+    LookAndFeel_V4::drawLinearSlider(g, x, y, width, height, sliderPos, minSliderPos, maxSliderPos, style, slider);
+}
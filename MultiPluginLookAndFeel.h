@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    This file contains the look and feel shared by every editor of the plugin.
+
+    The colours that every slider, button, menu and label of the editor used to set by hand are the defaults of this
+    look and feel, so an editor only sets the colours that differ. One instance is shared by every open editor
+    (juce::SharedResourcePointer), together with its image cache: the background arc of the knobs and the glow of a
+    dragged slider are rendered once per size into images and only drawn afterwards, instead of stroking the arc and
+    blurring the glow (juce::GlowEffect renders the whole component offscreen) on every repaint.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class MultiPluginLookAndFeel  : public juce::LookAndFeel_V4
+{
+public:
+    MultiPluginLookAndFeel(); //Sets the colours shared by the editors
+
+    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos,
+                          float startAngle, float endAngle, juce::Slider& slider) override;
+    void drawLinearSlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float minSliderPos,
+                          float maxSliderPos, juce::Slider::SliderStyle style, juce::Slider& slider) override;
+
+    static void setGlowing(juce::Slider& slider, bool shouldGlow); //Marks a slider that is being dragged, its glow is drawn behind it
+    void setImageCachingEnabled(bool shouldCache) noexcept { imageCachingEnabled = shouldCache; } //Off renders the arcs and the glows on every paint (Used by the benchmark)
+
+private:
+    enum class ImageType { knobBackground, knobGlow, linearGlow };
+
+    //Returns the cached image of a part of a slider (Rendered on the first use of a size, colour and display scale)
+    const juce::Image& getCachedImage(ImageType type, int width, int height, float scale, juce::Colour colour);
+    static void renderImage(juce::Graphics& g, ImageType type, float width, float height, juce::Colour colour);
+    void drawPart(juce::Graphics& g, ImageType type, juce::Rectangle<int> area, juce::Colour colour);
+
+    static constexpr float rotaryStartAngle = juce::MathConstants<float>::pi * 1.2f; //Default angles of juce::Slider, the cached arcs are drawn with them
+    static constexpr float rotaryEndAngle = juce::MathConstants<float>::pi * 2.8f;
+    static constexpr int glowRadius = 5; //Same radius as the glow effect it replaced
+    static constexpr size_t maximumCachedImages = 64; //Sizes are few (Every editor has the same layout), the cache is only cleared if that is exceeded
+
+    std::map<std::tuple<ImageType, int, int, juce::uint32>, juce::Image> cachedImages; //Image of every part, size (In physical pixels) and colour
+    bool imageCachingEnabled = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiPluginLookAndFeel)
+};
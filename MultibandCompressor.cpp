@@ -0,0 +1,577 @@
+/*
+  ==============================================================================
+
+    This file contains the multiband compressor of the plugin.
+
+    The crossovers use the equations of juce::dsp::StateVariableTPTFilter with a Butterworth resonance. The low pass
+    and the high pass of a Linkwitz-Riley crossover add up to the allpass x - 2 * R2 * yBP of the same filter, which is
+    what the lower bands go through for every crossover above them.
+
+  ==============================================================================
+*/
+
+#include "MultibandCompressor.h"
+#include "FastMath.h"
+
+//==============================================================================
+namespace
+{
+    constexpr double butterworthR2 = juce::MathConstants<double>::sqrt2; //1 / Q of a Butterworth filter
+
+    //One sample of a state variable filter (Same equations as juce::dsp::StateVariableTPTFilter), on a register or on a plain sample
+    template <typename T>
+    forcedinline void tick(T x, T& s1, T& s2, T g, T h, T gPlusR2, T& yLP, T& yBP, T& yHP) noexcept
+    {
+        yHP = h * (x - s1 * gPlusR2 - s2);
+        yBP = yHP * g + s1;
+        s1 = yHP * g + yBP;
+        yLP = yBP * g + s2;
+        s2 = yBP * g + yLP;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandCompressor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate;
+    maximumBlockSize = (int) spec.maximumBlockSize;
+
+    const auto numGroups = (spec.numChannels + numLanes - 1) / numLanes; //Groups of channels that share a register
+    groups.resize(numGroups);
+    bandBuffer.assign(numGroups * maximumNumBands * (size_t) maximumBlockSize, Register::expand(0));
+    keyBandBuffer.assign(numGroups * maximumNumBands * (size_t) maximumBlockSize, Register::expand(0));
+    gainBuffer.assign((size_t) maximumBlockSize, Register::expand(0));
+    levelBuffer.assign(numGroups * (size_t) maximumBlockSize, Register::expand(0));
+    linkedGains.assign((size_t) maximumBlockSize, SampleType(1));
+    rmsWindow.prepare(numGroups * maximumNumBands, (int) std::ceil(maximumRmsWindowMs * 0.001 * sampleRate));
+
+    for (int crossover = 0; crossover < maximumNumBands - 1; ++crossover)
+        updateCrossover(crossover);
+
+    for (int band = 0; band < maximumNumBands; ++band)
+        setThreshold(band, thresholddBs[(size_t) band]);
+
+    setAttack(attackTime);
+    setRelease(releaseTime);
+    setRmsWindow(rmsWindowTime);
+    reset();
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::reset() noexcept
+{
+    const auto zero = Register::expand(0);
+
+    for (auto& group : groups)
+    {
+        for (auto& crossover : group.crossovers)
+            for (auto& filter : crossover)
+                filter = { zero, zero };
+
+        for (auto& filter : group.allpasses)
+            filter = { zero, zero };
+
+        for (auto& crossover : group.keyCrossovers)
+            for (auto& filter : crossover)
+                filter = { zero, zero };
+    }
+
+    resetEnvelopes();
+    rmsWindow.reset();
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::resetEnvelopes() noexcept
+{
+    for (auto& group : groups)
+        group.envelopes.fill(Register::expand(0));
+
+    linkedEnvelopes.fill(SampleType(0));
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setNumBands(int newNumBands) noexcept
+{
+    jassert(newNumBands == 3 || newNumBands == maximumNumBands);
+
+    if (numBands != newNumBands)
+    {
+        numBands = newNumBands;
+        reset(); //The last crossover and the allpasses are only used with 4 bands, so their state is old
+    }
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setCrossoverFrequency(int crossoverIndex, SampleType newFrequencyHz) noexcept
+{
+    jassert(juce::isPositiveAndBelow(crossoverIndex, maximumNumBands - 1));
+    jassert(juce::isPositiveAndBelow(newFrequencyHz, static_cast<SampleType>(sampleRate * 0.5)));
+
+    crossoverFrequencies[(size_t) crossoverIndex] = newFrequencyHz;
+    updateCrossover(crossoverIndex);
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setThreshold(int band, SampleType newThresholddB) noexcept
+{
+    jassert(juce::isPositiveAndBelow(band, maximumNumBands));
+
+    thresholddBs[(size_t) band] = newThresholddB;
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setRatio(SampleType newRatio) noexcept
+{
+    jassert(newRatio >= SampleType(1.0));
+
+    ratio = newRatio;
+    ratioInverse = SampleType(1.0) / ratio;
+    updateKnee();
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setAttack(SampleType newAttackMs) noexcept
+{
+    attackTime = newAttackMs;
+    cteAT = calculateLimitedCte(attackTime);
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setRelease(SampleType newReleaseMs) noexcept
+{
+    releaseTime = newReleaseMs;
+    cteRL = calculateLimitedCte(releaseTime);
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setKnee(SampleType newKneedB) noexcept
+{
+    jassert(newKneedB >= 0);
+
+    kneedB = newKneedB;
+    updateKnee();
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setLinked(bool shouldBeLinked) noexcept
+{
+    const auto wasFullyLinked = isFullyLinked();
+    linked = shouldBeLinked;
+
+    if (wasFullyLinked != isFullyLinked())
+        resetEnvelopes(); //Fully linked, every band has a single envelope, so the envelopes of the other mode are old
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setLinkAmount(SampleType newLinkAmount) noexcept
+{
+    jassert(newLinkAmount >= 0 && newLinkAmount <= SampleType(1.0));
+
+    const auto wasFullyLinked = isFullyLinked();
+    linkAmount = newLinkAmount;
+
+    if (wasFullyLinked != isFullyLinked())
+        resetEnvelopes();
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setRmsDetector(bool shouldUseRms) noexcept
+{
+    if (rms != shouldUseRms)
+    {
+        rms = shouldUseRms;
+        rmsWindow.reset(); //The squares are not written while the peak is detected, so what is left in the windows is old
+    }
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::setRmsWindow(SampleType newWindowMs) noexcept
+{
+    jassert(newWindowMs > 0 && newWindowMs <= maximumRmsWindowMs);
+
+    rmsWindowTime = newWindowMs;
+    rmsWindow.setWindow(juce::jmax(1, (int) std::round(rmsWindowTime * 0.001 * sampleRate)));
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::updateCrossover(int crossoverIndex) noexcept
+{
+    const auto index = (size_t) crossoverIndex;
+    g[index] = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * crossoverFrequencies[index] / sampleRate));
+    h[index] = static_cast<SampleType>(1.0 / (1.0 + butterworthR2 * g[index] + g[index] * g[index]));
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::updateKnee() noexcept
+{
+    kneeCurve = kneedB > 0 ? (ratioInverse - SampleType(1.0)) / (SampleType(2.0) * kneedB) : SampleType(0);
+}
+
+template <typename SampleType>
+SampleType MultibandCompressor<SampleType>::calculateLimitedCte(SampleType timeMs) const noexcept
+{
+    return timeMs < static_cast<SampleType>(1.0e-3) ? 0 : static_cast<SampleType>(std::exp(expFactor / timeMs));
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::computeGains(SampleType* envelopesToGains, int numValues, int band) const noexcept
+{
+    //Same curve as MultiChannelCompressor::computeGains(), in dB over the whole block
+    const auto kneeBottomdB = thresholddBs[(size_t) band] - kneedB * SampleType(0.5);
+    const auto slope = ratioInverse - SampleType(1.0);
+
+    FastMath::gainToDecibels(envelopesToGains, envelopesToGains, numValues, SampleType(-200.0));
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        const auto overdB = envelopesToGains[i] - kneeBottomdB;
+        const auto insideKnee = SampleType(0.5) * (std::abs(overdB) - std::abs(overdB - kneedB) + kneedB); //overdB limited to 0 to kneedB
+        const auto aboveKnee = SampleType(0.5) * (overdB - kneedB + std::abs(overdB - kneedB)); //0 under the top of the knee
+        envelopesToGains[i] = kneeCurve * insideKnee * insideKnee + slope * aboveKnee;
+    }
+
+    FastMath::decibelsToGain(envelopesToGains, envelopesToGains, numValues, SampleType(-200.0));
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::detect(size_t group, int band, const Register* samples, int numSamples) noexcept
+{
+    auto* levels = getLevels(group);
+
+    if (! rms)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            levels[i] = Register::abs(samples[i]); //Peak
+        return;
+    }
+
+    rmsWindow.process(group * maximumNumBands + (size_t) band, samples, levels, numSamples); //Mean square of every lane over the window, O(1) per sample
+    auto* rawLevels = reinterpret_cast<SampleType*>(levels); //The registers have no square root, every lane is done on its own
+
+    for (int i = 0; i < numSamples * (int) numLanes; ++i)
+        rawLevels[i] = std::sqrt(rawLevels[i]);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandCompressor<SampleType>::interleave(Register* destination, const juce::dsp::AudioBlock<const SampleType>& source, size_t group, int numChannels, int numSamples) const noexcept
+{
+    const auto firstChannel = (int) (group * numLanes);
+    const auto numGroupChannels = juce::jmin((int) numLanes, numChannels - firstChannel);
+    const auto numSourceChannels = (int) source.getNumChannels();
+    auto* scratch = reinterpret_cast<SampleType*>(destination); //Sample i of lane l is at scratch[i * numLanes + l]
+
+    if (numGroupChannels < (int) numLanes) //The unused lanes stay at zero
+        std::fill(destination, destination + numSamples, Register::expand(0));
+
+    for (int lane = 0; lane < numGroupChannels; ++lane)
+    {
+        const auto* channelData = source.getChannelPointer((size_t) ((firstChannel + lane) % numSourceChannels)); //A mono key goes into every lane
+
+        for (int i = 0; i < numSamples; ++i)
+            scratch[(size_t) i * numLanes + (size_t) lane] = channelData[i];
+    }
+}
+
+template <typename SampleType>
+template <int numSplitBands, bool isKey>
+void MultibandCompressor<SampleType>::split(size_t group, int numSamples) noexcept
+{
+    auto& state = groups[group];
+    auto& crossovers = isKey ? state.keyCrossovers : state.crossovers;
+    std::array<Register*, maximumNumBands> bands;
+
+    for (int band = 0; band < maximumNumBands; ++band)
+        bands[(size_t) band] = isKey ? getKeyBand(group, band) : getBand(group, band);
+
+    std::array<Register, maximumNumBands - 1> gRegister, hRegister, gPlusR2;
+
+    for (size_t i = 0; i < gRegister.size(); ++i)
+    {
+        gRegister[i] = Register::expand(g[i]);
+        hRegister[i] = Register::expand(h[i]);
+        gPlusR2[i] = Register::expand(g[i] + static_cast<SampleType>(butterworthR2));
+    }
+
+    const auto twoR2 = Register::expand(static_cast<SampleType>(2.0 * butterworthR2));
+
+    //Linkwitz-Riley crossover: one filter, then a second low pass on its low pass and a second high pass on its high pass
+    auto crossover = [&](size_t index, Register x, Register& low, Register& high)
+    {
+        auto& filters = crossovers[index];
+        Register lp, bp, hp, unused1, unused2;
+        tick(x, filters[0].s1, filters[0].s2, gRegister[index], hRegister[index], gPlusR2[index], lp, bp, hp);
+        tick(lp, filters[1].s1, filters[1].s2, gRegister[index], hRegister[index], gPlusR2[index], low, unused1, unused2);
+        tick(hp, filters[2].s1, filters[2].s2, gRegister[index], hRegister[index], gPlusR2[index], unused1, unused2, high);
+    };
+
+    //Allpass of a crossover (Same phase as its low pass plus its high pass)
+    auto allpass = [&](size_t index, FilterState& filter, Register x)
+    {
+        Register lp, bp, hp;
+        tick(x, filter.s1, filter.s2, gRegister[index], hRegister[index], gPlusR2[index], lp, bp, hp);
+        return x - twoR2 * bp;
+    };
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        Register band0, band1, rest;
+        crossover(0, bands[0][i], band0, rest);
+        crossover(1, rest, band1, rest);
+
+        if constexpr (numSplitBands == 4)
+        {
+            crossover(2, rest, bands[2][i], bands[3][i]);
+
+            if constexpr (! isKey) //The bands of the key are only detected, so they do not need the same phase
+            {
+                band0 = allpass(2, state.allpasses[1], allpass(1, state.allpasses[0], band0));
+                band1 = allpass(2, state.allpasses[2], band1);
+            }
+        }
+        else
+        {
+            bands[2][i] = rest;
+
+            if constexpr (! isKey)
+                band0 = allpass(1, state.allpasses[0], band0);
+        }
+
+        bands[0][i] = band0;
+        bands[1][i] = band1;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandCompressor<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+    compress(context, nullptr); //Every band is keyed by itself
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context, const juce::dsp::AudioBlock<const SampleType>& keyBlock) noexcept
+{
+    jassert(keyBlock.getNumChannels() > 0 && keyBlock.getNumSamples() >= context.getOutputBlock().getNumSamples());
+    jassert(keyBlock.getNumChannels() == 1 || keyBlock.getNumChannels() >= context.getOutputBlock().getNumChannels()); //A mono key or one key channel for every channel
+    compress(context, &keyBlock);
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::compress(const juce::dsp::ProcessContextReplacing<SampleType>& context, const juce::dsp::AudioBlock<const SampleType>* keyBlock) noexcept
+{
+    auto& block = context.getOutputBlock();
+    const auto numChannels = (int) block.getNumChannels();
+    const auto numSamples = (int) block.getNumSamples();
+    const auto numGroups = ((size_t) numChannels + numLanes - 1) / numLanes;
+
+    jassert(numSamples <= maximumBlockSize);
+    jassert(numGroups <= groups.size());
+
+    if (context.isBypassed)
+        return;
+
+    //Interleaving the channels of every group into its band 0 and splitting it into the bands (The key too when there is one)
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        interleave(getBand(group, 0), context.getInputBlock(), group, numChannels, numSamples);
+
+        if (numBands == maximumNumBands)
+            split<maximumNumBands, false>(group, numSamples);
+        else
+            split<3, false>(group, numSamples);
+
+        if (keyBlock != nullptr)
+        {
+            interleave(getKeyBand(group, 0), *keyBlock, group, numChannels, numSamples);
+
+            if (numBands == maximumNumBands)
+                split<maximumNumBands, true>(group, numSamples);
+            else
+                split<3, true>(group, numSamples);
+        }
+    }
+
+    //Level, envelope and gain of every band
+    auto* rawGains = reinterpret_cast<SampleType*>(gainBuffer.data());
+    const auto link = linked ? linkAmount : SampleType(0);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        for (size_t group = 0; group < numGroups; ++group)
+            detect(group, band, keyBlock != nullptr ? getKeyBand(group, band) : getBand(group, band), numSamples);
+
+        if (link > 0)
+        {
+            //Loudest channel of every sample (The unused lanes are zero so they are never the loudest)
+            std::fill(gainBuffer.begin(), gainBuffer.begin() + numSamples, Register::expand(0));
+
+            for (size_t group = 0; group < numGroups; ++group)
+            {
+                const auto* levels = getLevels(group);
+
+                for (int i = 0; i < numSamples; ++i)
+                    gainBuffer[(size_t) i] = Register::max(gainBuffer[(size_t) i], levels[i]);
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto level = SampleType(0);
+
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                    level = juce::jmax(level, rawGains[(size_t) i * numLanes + lane]);
+
+                linkedGains[(size_t) i] = level;
+            }
+        }
+
+        if (! isFullyLinked())
+        {
+            //Every lane has its own envelope, so the envelopes of numLanes channels are updated with each instruction. The attack
+            //or release coefficient is chosen without a branch: the envelope rises when the level is above it (A negative difference).
+            const auto attack = Register::expand(cteAT), release = Register::expand(cteRL), zero = Register::expand(0);
+            const auto linkRegister = Register::expand(link);
+
+            for (size_t group = 0; group < numGroups; ++group)
+            {
+                auto* samples = getBand(group, band);
+                const auto* levels = getLevels(group);
+                auto envelope = groups[group].envelopes[(size_t) band];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto level = levels[i];
+
+                    if (link > 0) //Partly moved towards the loudest channel
+                        level += (Register::expand(linkedGains[(size_t) i]) - level) * linkRegister;
+
+                    const auto difference = envelope - level;
+                    envelope = level + Register::min(difference, zero) * attack + Register::max(difference, zero) * release;
+                    gainBuffer[(size_t) i] = envelope;
+                }
+
+                groups[group].envelopes[(size_t) band] = envelope;
+                computeGains(rawGains, numSamples * (int) numLanes, band);
+
+                for (int i = 0; i < numSamples; ++i)
+                    samples[i] *= gainBuffer[(size_t) i];
+            }
+        }
+        else
+        {
+            //The loudest channel of every sample drives one envelope per band, the gain computer runs once per sample for all channels
+            auto envelope = linkedEnvelopes[(size_t) band];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto level = linkedGains[(size_t) i];
+                envelope = level + (level > envelope ? cteAT : cteRL) * (envelope - level);
+                linkedGains[(size_t) i] = envelope;
+            }
+
+            linkedEnvelopes[(size_t) band] = envelope;
+            computeGains(linkedGains.data(), numSamples, band);
+
+            for (size_t group = 0; group < numGroups; ++group)
+            {
+                auto* samples = getBand(group, band);
+
+                for (int i = 0; i < numSamples; ++i)
+                    samples[i] *= Register::expand(linkedGains[(size_t) i]);
+            }
+        }
+    }
+
+    if (rms)
+        rmsWindow.advance(numSamples);
+
+    //Adding the bands back together and writing the result to the channels
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        const auto firstChannel = (int) (group * numLanes);
+        const auto numGroupChannels = juce::jmin((int) numLanes, numChannels - firstChannel);
+        auto* output = getBand(group, 0);
+        auto* scratch = reinterpret_cast<const SampleType*>(output);
+
+        for (int band = 1; band < numBands; ++band)
+        {
+            const auto* samples = getBand(group, band);
+
+            for (int i = 0; i < numSamples; ++i)
+                output[i] += samples[i];
+        }
+
+        for (int lane = 0; lane < numGroupChannels; ++lane)
+        {
+            auto* channelData = block.getChannelPointer((size_t) (firstChannel + lane));
+
+            for (int i = 0; i < numSamples; ++i)
+                channelData[i] = scratch[(size_t) i * numLanes + (size_t) lane];
+        }
+    }
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    snapToZero();
+   #endif
+}
+
+template <typename SampleType>
+void MultibandCompressor<SampleType>::snapToZero() noexcept
+{
+    auto snapFilter = [](FilterState& filter)
+    {
+        for (auto* state : { &filter.s1, &filter.s2 })
+        {
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto value = state->get(lane);
+                juce::dsp::util::snapToZero(value);
+                state->set(lane, value);
+            }
+        }
+    };
+
+    for (auto& group : groups)
+    {
+        for (auto& crossover : group.crossovers)
+            for (auto& filter : crossover)
+                snapFilter(filter);
+
+        for (auto& filter : group.allpasses)
+            snapFilter(filter);
+
+        for (auto& crossover : group.keyCrossovers)
+            for (auto& filter : crossover)
+                snapFilter(filter);
+    }
+}
+
+template <typename SampleType>
+SampleType MultibandCompressor<SampleType>::getGain() const noexcept
+{
+    auto gain = SampleType(1);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto envelope = linkedEnvelopes[(size_t) band];
+
+        if (! isFullyLinked()) //Loudest channel of the band (The lanes without a channel stay at zero)
+            for (auto& group : groups)
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                    envelope = juce::jmax(envelope, group.envelopes[(size_t) band].get(lane));
+
+        computeGains(&envelope, 1, band);
+        gain = juce::jmin(gain, envelope);
+    }
+
+    return gain;
+}
+
+//==============================================================================
+template class MultibandCompressor<float>;
+template class MultibandCompressor<double>;
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    This file contains the multiband compressor of the plugin.
+
+    The signal is split into 3 or 4 bands with Linkwitz-Riley crossovers (4th order, two Butterworth state variable
+    filters in a row). The lower bands go through the allpass of every crossover above them, so the bands add back
+    up to a flat magnitude and the same phase at every frequency. Every band has its own envelope and threshold,
+    the ratio, the knee, the ballistics, the detector and the linking are shared (Same as MultiChannelCompressor).
+
+    Like the SIMD state variable filter, the channels are interleaved into juce::dsp::SIMDRegister lanes, so 4 (SSE/
+    NEON) or 8 (AVX) channels go through the crossovers, the RMS windows and the envelopes of every band with each
+    instruction. The split into bands is one fused loop that is compiled for 3 and for 4 bands. Fully linked, every
+    band has one envelope and runs its gain computer once per sample for all the channels. Every buffer is allocated
+    in prepare().
+
+    Keyed by another signal (The sidechain bus of the host), the key goes through its own crossovers (Without the
+    allpasses, the detector does not need the phase) and every band is keyed by the same band of the key. The
+    highpass of the key is left to MultiChannelCompressor, the crossovers already keep the low end out of the bands
+    above the first one.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SlidingWindowRms.h"
+
+//==============================================================================
+template <typename SampleType>
+class MultibandCompressor
+{
+public:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Register::SIMDNumElements; //Channels processed by one register
+    static constexpr int maximumNumBands = 4;
+    static constexpr double maximumRmsWindowMs = 50.0; //Longest RMS window, the squares are kept for it
+
+    //==============================================================================
+    void prepare(const juce::dsp::ProcessSpec& spec); //Allocates the state, the band buffers and the RMS windows
+    void reset() noexcept; //Clears the crossovers, the envelopes and the RMS windows
+
+    void setNumBands(int newNumBands) noexcept; //3 or 4
+    void setCrossoverFrequency(int crossoverIndex, SampleType newFrequencyHz) noexcept; //Crossover between the band crossoverIndex and the next one
+    void setThreshold(int band, SampleType newThresholddB) noexcept; //Threshold of one band in dB
+    void setRatio(SampleType newRatio) noexcept; //Ratio of every band (1 or higher)
+    void setAttack(SampleType newAttackMs) noexcept; //Attack of every band in ms
+    void setRelease(SampleType newReleaseMs) noexcept; //Release of every band in ms
+    void setKnee(SampleType newKneedB) noexcept; //Width of the soft knee of every band in dB (0 is a hard knee)
+    void setLinked(bool shouldBeLinked) noexcept; //Moves the level of every channel towards the loudest one in each band by the link amount
+    void setLinkAmount(SampleType newLinkAmount) noexcept; //0 to 1, at 1 every channel gets the same gain in each band
+    void setRmsDetector(bool shouldUseRms) noexcept; //RMS over a sliding window instead of the peak
+    void setRmsWindow(SampleType newWindowMs) noexcept; //Length of the RMS window in ms (Up to maximumRmsWindowMs)
+
+    //==============================================================================
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept; //Compresses every channel of the block in place
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context, const juce::dsp::AudioBlock<const SampleType>& keyBlock) noexcept; //Same with the levels of the bands of the key
+    SampleType getGain() const noexcept; //Gain of the band compressed the most, for the loudest channel at the end of the last block (Used by the meters)
+
+private:
+    struct FilterState { Register s1, s2; }; //Integrators of one state variable filter
+    struct GroupState //Everything a group of numLanes channels keeps between blocks
+    {
+        std::array<std::array<FilterState, 3>, maximumNumBands - 1> crossovers {}; //First filter, low pass and high pass of every crossover
+        std::array<FilterState, 3> allpasses {}; //Band 0 at crossover 1 and 2, band 1 at crossover 2
+        std::array<Register, maximumNumBands> envelopes {}; //Envelope of every band
+        std::array<std::array<FilterState, 3>, maximumNumBands - 1> keyCrossovers {}; //Crossovers of the key
+    };
+
+    void compress(const juce::dsp::ProcessContextReplacing<SampleType>& context, const juce::dsp::AudioBlock<const SampleType>* keyBlock) noexcept; //Shared by both process()
+    void interleave(Register* destination, const juce::dsp::AudioBlock<const SampleType>& source, size_t group, int numChannels, int numSamples) const noexcept; //Channels of a group into the lanes
+    template <int numSplitBands, bool isKey>
+    void split(size_t group, int numSamples) noexcept; //Splits band 0 of a group into every band (Compiled for 3 and for 4 bands, and for the key)
+    void updateCrossover(int crossoverIndex) noexcept; //Recomputes the coefficients of one crossover
+    SampleType calculateLimitedCte(SampleType timeMs) const noexcept; //Coefficient of the ballistics (Same as juce::dsp::BallisticsFilter)
+    void snapToZero() noexcept; //Removes denormals from the state of the crossovers
+    void computeGains(SampleType* envelopesToGains, int numValues, int band) const noexcept; //Gain computer of one band, in place
+    void detect(size_t group, int band, const Register* samples, int numSamples) noexcept; //Level of every sample of one band of a group
+    void updateKnee() noexcept; //Recomputes the curve of the knee (Depends on the ratio and the width)
+    void resetEnvelopes() noexcept;
+    bool isFullyLinked() const noexcept { return linked && linkAmount >= SampleType(1.0); }
+    Register* getBand(size_t group, int band) noexcept { return bandBuffer.data() + (group * maximumNumBands + (size_t) band) * (size_t) maximumBlockSize; }
+    Register* getKeyBand(size_t group, int band) noexcept { return keyBandBuffer.data() + (group * maximumNumBands + (size_t) band) * (size_t) maximumBlockSize; }
+    Register* getLevels(size_t group) noexcept { return levelBuffer.data() + group * (size_t) maximumBlockSize; }
+
+    //==============================================================================
+    int numBands = 3;
+    std::array<SampleType, maximumNumBands - 1> crossoverFrequencies { SampleType(200), SampleType(1500), SampleType(6000) };
+    std::array<SampleType, maximumNumBands - 1> g {}, h {}; //Coefficients of the crossovers (Same names as the JUCE filter)
+    std::array<SampleType, maximumNumBands> thresholddBs {}; //Threshold of every band
+    SampleType ratio = 1, ratioInverse = 1, attackTime = 1, releaseTime = 100, cteAT = 0, cteRL = 0;
+    SampleType kneedB = 0, kneeCurve = 0, linkAmount = 1, rmsWindowTime = 10;
+    double sampleRate = 44100.0, expFactor = 0;
+    bool linked = false, rms = false;
+
+    std::vector<GroupState> groups; //One for every group of numLanes channels
+    std::vector<Register> bandBuffer; //Samples of every band of every group for one block
+    std::vector<Register> keyBandBuffer; //Same for the key
+    std::vector<Register> gainBuffer; //Envelopes and then gains of one band
+    std::vector<Register> levelBuffer; //Detected level of every sample of one band of every group
+    SlidingWindowRms<Register> rmsWindow; //Running mean square of every band of every group
+    std::array<SampleType, maximumNumBands> linkedEnvelopes {}; //Envelope of every band when linked
+    std::vector<SampleType> linkedGains; //Level of the loudest channel of every sample of one band when linked, then its gain when fully linked
+    int maximumBlockSize = 0;
+};
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    This file contains the parameter cache of the processor.
+
+    The cache keeps the last value of every parameter that was sent to the DSP processes. When the audio thread
+    updates it, it returns which parameters actually moved, so only the coefficients that depend on them get
+    recomputed (tan() in the filter, exp() in the compressor ballistics and pow() in the gain).
+
+    When the host switches programs, the audio thread puts the snapshot of the preset straight into the cache and
+    holds it there until the message thread has sent the same values to the parameters of the host.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginParameters.h"
+
+//==============================================================================
+class ParameterCache
+{
+public:
+    //Indexes of the cached parameters (Same order as the IDs inside parameterIDs)
+    enum Parameter
+    {
+        pluginType = 0,
+        filterFrequency, filterResonance, filterType, filterOversampling, filterOversamplingType, filterSlope, filterTopology, //Filter
+        filterLfoShape, filterLfoRate, filterLfoSync, filterLfoDivision, filterLfoCutoff, filterLfoResonance, //Filter Modulation
+        filterEnvelopeAttack, filterEnvelopeRelease, filterEnvelopeCutoff, filterEnvelopeResonance, filterControlRate,
+        compressorAttack, compressorRatio, compressorRelease, compressorThreshold, compressorLink, compressorLookahead, //Compressor
+        compressorDetector, compressorRmsWindow, compressorLinkAmount, compressorKnee,
+        compressorSidechain, compressorSidechainHighpass, compressorSidechainFrequency,
+        compressorMultiband, compressorBands, compressorCrossoverLow, compressorCrossoverMid, compressorCrossoverHigh, //Multiband Compressor
+        compressorBand1Threshold, compressorBand2Threshold, compressorBand3Threshold, compressorBand4Threshold,
+        gainGain, //Gain
+        chainOrder, chainFilter, chainCompressor, chainGain, //Chain
+        numParameters
+    };
+
+    using Mask = juce::uint64; //One bit for each parameter
+    static constexpr Mask allParameters = (Mask(1) << numParameters) - 1;
+    static_assert (numParameters < 64, "The change mask has one bit per parameter");
+
+    static constexpr Mask bit(Parameter parameter) noexcept { return Mask(1) << parameter; } //Bit of a parameter inside a change mask
+
+    using Snapshot = std::array<float, numParameters>; //Plain value of every parameter (Used by the presets)
+
+    static constexpr const char* parameterIDs[numParameters] = //ID of every cached parameter
+    {
+        ParameterIDs::pluginType,
+        ParameterIDs::filterFrequency, ParameterIDs::filterResonance, ParameterIDs::filterType, ParameterIDs::filterOversampling, ParameterIDs::filterOversamplingType,
+        ParameterIDs::filterSlope, ParameterIDs::filterTopology,
+        ParameterIDs::filterLfoShape, ParameterIDs::filterLfoRate, ParameterIDs::filterLfoSync, ParameterIDs::filterLfoDivision, ParameterIDs::filterLfoCutoff,
+        ParameterIDs::filterLfoResonance, ParameterIDs::filterEnvelopeAttack, ParameterIDs::filterEnvelopeRelease, ParameterIDs::filterEnvelopeCutoff,
+        ParameterIDs::filterEnvelopeResonance, ParameterIDs::filterControlRate,
+        ParameterIDs::compressorAttack, ParameterIDs::compressorRatio, ParameterIDs::compressorRelease, ParameterIDs::compressorThreshold, ParameterIDs::compressorLink, ParameterIDs::compressorLookahead,
+        ParameterIDs::compressorDetector, ParameterIDs::compressorRmsWindow, ParameterIDs::compressorLinkAmount, ParameterIDs::compressorKnee,
+        ParameterIDs::compressorSidechain, ParameterIDs::compressorSidechainHighpass, ParameterIDs::compressorSidechainFrequency,
+        ParameterIDs::compressorMultiband, ParameterIDs::compressorBands, ParameterIDs::compressorCrossoverLow, ParameterIDs::compressorCrossoverMid, ParameterIDs::compressorCrossoverHigh,
+        ParameterIDs::compressorBand1Threshold, ParameterIDs::compressorBand2Threshold, ParameterIDs::compressorBand3Threshold, ParameterIDs::compressorBand4Threshold,
+        ParameterIDs::gainGain,
+        ParameterIDs::chainOrder, ParameterIDs::chainFilter, ParameterIDs::chainCompressor, ParameterIDs::chainGain
+    };
+
+    //==============================================================================
+    void attach(juce::AudioProcessorValueTreeState& parameters) //Gets the atomic values of the parameters (Called once from the constructor of the processor)
+    {
+        for (int i = 0; i < numParameters; ++i)
+        {
+            sources[(size_t) i] = parameters.getRawParameterValue(parameterIDs[i]);
+            jassert(sources[(size_t) i] != nullptr); //The ID is missing from createParameterLayout()
+            values[(size_t) i] = sources[(size_t) i]->load();
+        }
+
+        invalidate();
+    }
+
+    void invalidate() noexcept //Makes the next update report every parameter as changed (Used after prepareToPlay)
+    {
+        forceAll = true;
+    }
+
+    Mask update() noexcept //Reads every parameter and returns the mask of the ones that changed since the last update (Audio thread)
+    {
+        Mask changed = forceAll ? allParameters : 0;
+        forceAll = false;
+
+        if (held) //The values of a program are kept until the parameters of the host have them too
+            return changed;
+
+        for (int i = 0; i < numParameters; ++i)
+        {
+            const auto newValue = sources[(size_t) i]->load(std::memory_order_relaxed);
+
+            if (newValue != values[(size_t) i]) //Only exact changes count, the parameters are already quantised by their ranges
+            {
+                values[(size_t) i] = newValue;
+                changed |= bit((Parameter) i);
+            }
+        }
+
+        return changed;
+    }
+
+    Mask hold(const Snapshot& snapshot) noexcept //Takes the values of a program and ignores the parameters until release() (Audio thread)
+    {
+        Mask changed = 0;
+
+        for (int i = 0; i < numParameters; ++i)
+        {
+            if (snapshot[(size_t) i] != values[(size_t) i])
+            {
+                values[(size_t) i] = snapshot[(size_t) i];
+                changed |= bit((Parameter) i);
+            }
+        }
+
+        held = true;
+        return changed;
+    }
+
+    void release() noexcept //Follows the parameters again, the next update() reports what differs from the program
+    {
+        held = false;
+    }
+
+    float get(Parameter parameter) const noexcept { return values[(size_t) parameter]; } //Last value read by update()
+    int getInt(Parameter parameter) const noexcept { return (int) values[(size_t) parameter]; } //Used for the choice parameters
+    bool getBool(Parameter parameter) const noexcept { return values[(size_t) parameter] >= 0.5f; } //Used for the bool parameters
+
+private:
+    std::array<std::atomic<float>*, numParameters> sources {}; //Atomic values inside the AudioProcessorValueTreeState
+    std::array<float, numParameters> values {}; //Values last sent to the DSP processes
+    bool forceAll = true;
+    bool held = false; //Set while a program is ahead of the parameters
+};
@@ -16,17 +16,18 @@
 MultiPluginAudioProcessorEditor::MultiPluginAudioProcessorEditor (MultiPluginAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p)
 {
+    //Look and feel (Shared by every open editor with its cached images, the UI elements get their colours from it)
+    setLookAndFeel(&lookAndFeel.get());
+    setOpaque(true); //paint() fills the whole window, so the host does not have to paint behind it
+
     //===========================================================MENUS===============================================================\\
 
     //Plugin Type Menu
     pluginTypeMenu.setJustificationType(juce::Justification::centred); //Sets the position of the text
     pluginTypeMenu.addItem("Filter", 1); //Adds an option
     pluginTypeMenu.addItem("Compressor", 2); //Adds an option
+    pluginTypeMenu.addItem("Chain", 3); //Adds an option
     pluginTypeMenu.setSelectedId(1); //Sets the initial state of the menu
-    //Plugin Type Menu Colours
-    pluginTypeMenu.setColour(0x1000a00, juce::Colour(0xffff88ff)); //Text
-    pluginTypeMenu.setColour(0x1000e00, juce::Colour(0xffff88ff)); //Arrow
-    pluginTypeMenu.setColour(0x1000c00, juce::Colour(0xffff88ff)); //Outline
     
     //Filter Type Menu
     filterTypeMenu.setJustificationType(juce::Justification::centred);
@@ -36,154 +37,189 @@ MultiPluginAudioProcessorEditor::MultiPluginAudioProcessorEditor (MultiPluginAud
     filterTypeMenu.setSelectedId(1);
     //Filter Type Menu Colours (Set in an if statement inside the ComboboxChanged function)
 
+    //Slope and Topology Menus (Cascaded state variable sections or a ladder, the ladder is always 24 dB/oct so the slope menu is disabled with it)
+    filterSlopeMenu.setJustificationType(juce::Justification::centred);
+    filterSlopeMenu.addItem("12 dB/oct", 1);
+    filterSlopeMenu.addItem("24 dB/oct", 2);
+    filterSlopeMenu.addItem("36 dB/oct", 3);
+    filterSlopeMenu.addItem("48 dB/oct", 4);
+    filterTopologyMenu.setJustificationType(juce::Justification::centred);
+    filterTopologyMenu.addItem("SVF", 1);
+    filterTopologyMenu.addItem("Ladder", 2);
+
+    //Oversampling Menus (Factor and type of the oversampling around the filter, the IIR type has a low latency and the FIR type a linear phase)
+    filterOversamplingMenu.setJustificationType(juce::Justification::centred);
+    filterOversamplingMenu.addItem("No Oversampling", 1);
+    filterOversamplingMenu.addItem("2x", 2);
+    filterOversamplingMenu.addItem("4x", 3);
+    filterOversamplingMenu.addItem("8x", 4);
+    filterOversamplingTypeMenu.setJustificationType(juce::Justification::centred);
+    filterOversamplingTypeMenu.addItem("IIR", 1);
+    filterOversamplingTypeMenu.addItem("FIR", 2);
+    //Filter Modulation Menus (Shape and synced length of the LFO, and the number of samples between two steps of the modulation)
+    filterLfoShapeMenu.setJustificationType(juce::Justification::centred);
+    filterLfoShapeMenu.addItem("Sine", 1);
+    filterLfoShapeMenu.addItem("Triangle", 2);
+    filterLfoShapeMenu.addItem("Saw", 3);
+    filterLfoShapeMenu.addItem("Square", 4);
+    filterLfoDivisionMenu.setJustificationType(juce::Justification::centred);
+    filterLfoDivisionMenu.addItemList({ "4 Bars", "2 Bars", "1 Bar", "1/2", "1/4", "1/8", "1/16", "1/4T", "1/8T", "1/16T" }, 1); //Same order as the choices of the parameter
+    filterControlRateMenu.setJustificationType(juce::Justification::centred);
+    filterControlRateMenu.addItem("Step 8", 1);
+    filterControlRateMenu.addItem("Step 16", 2);
+    filterControlRateMenu.addItem("Step 32", 3);
+    filterControlRateMenu.addItem("Step 64", 4);
+    //Chain Order Menu (Order of the stages when the plugin type is Chain)
+    chainOrderMenu.setJustificationType(juce::Justification::centred);
+    chainOrderMenu.addItem("Filter > Compressor > Gain", 1);
+    chainOrderMenu.addItem("Filter > Gain > Compressor", 2);
+    chainOrderMenu.addItem("Compressor > Filter > Gain", 3);
+    chainOrderMenu.addItem("Compressor > Gain > Filter", 4);
+    chainOrderMenu.addItem("Gain > Filter > Compressor", 5);
+    chainOrderMenu.addItem("Gain > Compressor > Filter", 6);
+    //Multiband Compressor Bands Menu
+    compressorBandsMenu.setJustificationType(juce::Justification::centred);
+    compressorBandsMenu.addItem("3 Bands", 1);
+    compressorBandsMenu.addItem("4 Bands", 2);
+    //Compressor Detector Menu (The RMS window bar next to it is disabled with the peak detector)
+    compressorDetectorMenu.setJustificationType(juce::Justification::centred);
+    compressorDetectorMenu.addItem("Peak", 1);
+    compressorDetectorMenu.addItem("RMS", 2);
+    //(The colours of the menus come from MultiPluginLookAndFeel, only the filter type menu changes its own)
+
     //==========================================================SLIDERS==============================================================\\
 
     //Frequency Slider
     filterFrequencySlider.setSliderStyle(juce::Slider::SliderStyle::Rotary); //Sets the style of the slider to rotary
     filterFrequencySlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20); //Sets the position and size of the textbox of the slider
-    filterFrequencySlider.setRange(20.0f, 20000.0f, 1.0f); //Sets the range of values of the sliders as well as the increment which it changes
-    filterFrequencySlider.setValue(audioProcessor.filterFrequency); //Sets the initial value to the value set from the audio processor
-    filterFrequencySlider.setTextValueSuffix("Hz"); //Sets a suffix after the displayed value inside the textbox
-    filterFrequencySlider.setSkewFactor(0.3, false); //Sets skew factor which makes the slider work in a logarithmic way (Applied only on this slider)
-    //Frequency Slider Colours
+    filterFrequencySlider.setTextValueSuffix("Hz"); //Sets a suffix after the displayed value inside the textbox (The range, the skew and the value come from the parameter attachment)
+    //Frequency Slider Colours (The other colours of every slider come from MultiPluginLookAndFeel, only the colours that differ are set here)
     filterFrequencySlider.setColour(0x1001311, juce::Colour(0xff4B0082)); //Before Knob (rotarySliderFillColourId = 0x1001311)
-    filterFrequencySlider.setColour(0x1001312, juce::Colour(0xdd111111)); //After Knob (rotarySliderOutlineColourId = 0x1001312)
-    filterFrequencySlider.setColour(0x1001500, juce::Colour(0x23ffffff)); //Textbox Backround (textBoxBackgroundColourId = 0x1001500)
-    filterFrequencySlider.setColour(0x1001300, juce::Colour(0xffdd00ff)); //Knob (thumbColourId = 0x1001300)
-    filterFrequencySlider.setColour(0x1001400, juce::Colour(0xffff88ff)); //Text (textBoxTextColourId = 0x1001400)
-    filterFrequencySlider.setColour(0x1001600, juce::Colour(0x9a8414ff)); //Text Highlight (textBoxHighlightColourId = 0x1001600)
-    filterFrequencySlider.setColour(0x1001700, juce::Colour(0x9fdd00ff)); //Textbox Border (textBoxOutlineColourId = 0x1001700)
 
     //Resonance Slider
     filterResonanceSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
     filterResonanceSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    filterResonanceSlider.setRange(1.0f, 10.0f, 0.1f);
-    filterResonanceSlider.setValue(audioProcessor.filterResonance);
     //Resonance Slider Colours
     filterResonanceSlider.setColour(0x1001311, juce::Colour(0x8fff3252));
-    filterResonanceSlider.setColour(0x1001312, juce::Colour(0xdd111111));
-    filterResonanceSlider.setColour(0x1001500, juce::Colour(0x23ffffff));
-    filterResonanceSlider.setColour(0x1001300, juce::Colour(0xffdd00ff));
-    filterResonanceSlider.setColour(0x1001400, juce::Colour(0xffff88ff));
-    filterResonanceSlider.setColour(0x1001600, juce::Colour(0x9a8414ff));
-    filterResonanceSlider.setColour(0x1001700, juce::Colour(0x9fdd00ff));
+
+    //Filter Modulation Sliders (Bars with the value written inside, in rows under the oversampling menus)
+    for (auto* bar : { &filterLfoRateSlider, &filterLfoCutoffSlider, &filterLfoResonanceSlider, &filterEnvelopeAttackSlider,
+                       &filterEnvelopeReleaseSlider, &filterEnvelopeCutoffSlider, &filterEnvelopeResonanceSlider })
+        bar->setSliderStyle(juce::Slider::SliderStyle::LinearBar);
+    filterLfoRateSlider.setTextValueSuffix(" Hz LFO");
+    filterLfoCutoffSlider.setTextValueSuffix(" oct LFO");
+    filterLfoResonanceSlider.setTextValueSuffix(" Res LFO");
+    filterEnvelopeAttackSlider.setTextValueSuffix(" ms Att");
+    filterEnvelopeReleaseSlider.setTextValueSuffix(" ms Rel");
+    filterEnvelopeCutoffSlider.setTextValueSuffix(" oct Env");
+    filterEnvelopeResonanceSlider.setTextValueSuffix(" Res Env");
+    filterLfoSyncButton.onClick = [this] //The synced LFO uses the division instead of the rate
+    {
+        filterLfoRateSlider.setEnabled(! filterLfoSyncButton.getToggleState());
+        filterLfoDivisionMenu.setEnabled(filterLfoSyncButton.getToggleState());
+    };
 
     //Compressor Attack Slider
     compressorAttackSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
     compressorAttackSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    compressorAttackSlider.setRange(0.01f, 300.0f, 0.0001f);
-    compressorAttackSlider.setValue(audioProcessor.compressorAttack);
     compressorAttackSlider.setTextValueSuffix("ms");
-    //Compressor Attack Slider Colours
-    compressorAttackSlider.setColour(0x1001311, juce::Colour(0x8f87cefa));
-    compressorAttackSlider.setColour(0x1001312, juce::Colour(0xdd111111));
-    compressorAttackSlider.setColour(0x1001500, juce::Colour(0x23ffffff));
-    compressorAttackSlider.setColour(0x1001300, juce::Colour(0xffdd00ff));
-    compressorAttackSlider.setColour(0x1001400, juce::Colour(0xffff88ff));
-    compressorAttackSlider.setColour(0x1001600, juce::Colour(0x9a8414ff));
-    compressorAttackSlider.setColour(0x1001700, juce::Colour(0x9fdd00ff));
 
     //Compressor Ratio Slider
     compressorRatioSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
     compressorRatioSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    compressorRatioSlider.setRange(1.0f, 10.0f, 1.0f);
-    compressorRatioSlider.setValue(audioProcessor.compressorRatio);
-    //Compressor Ratio Slider Colours
-    compressorRatioSlider.setColour(0x1001311, juce::Colour(0x8f87cefa));
-    compressorRatioSlider.setColour(0x1001312, juce::Colour(0xdd111111));
-    compressorRatioSlider.setColour(0x1001500, juce::Colour(0x23ffffff));
-    compressorRatioSlider.setColour(0x1001300, juce::Colour(0xffdd00ff));
-    compressorRatioSlider.setColour(0x1001400, juce::Colour(0xffff88ff));
-    compressorRatioSlider.setColour(0x1001700, juce::Colour(0x9fdd00ff));
 
     //Compressor Release Slider
     compressorReleaseSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
     compressorReleaseSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    compressorReleaseSlider.setRange(5.0f, 4000.0f, 0.1f);
-    compressorReleaseSlider.setValue(audioProcessor.compressorRelease);
     compressorReleaseSlider.setTextValueSuffix("ms");
-    //Compressor Release Slider Colours
-    compressorReleaseSlider.setColour(0x1001311, juce::Colour(0x8f87cefa));
-    compressorReleaseSlider.setColour(0x1001312, juce::Colour(0xdd111111));
-    compressorReleaseSlider.setColour(0x1001500, juce::Colour(0x23ffffff));
-    compressorReleaseSlider.setColour(0x1001300, juce::Colour(0xffdd00ff));
-    compressorReleaseSlider.setColour(0x1001400, juce::Colour(0xffff88ff));
-    compressorReleaseSlider.setColour(0x1001600, juce::Colour(0x9a8414ff));
-    compressorReleaseSlider.setColour(0x1001700, juce::Colour(0x9fdd00ff));
 
     //Compressor Threshold Slider
     compressorThresholdSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
     compressorThresholdSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    compressorThresholdSlider.setRange(-30.0f, 0.0f, 1.0f);
-    compressorThresholdSlider.setValue(audioProcessor.compressorThreshold);
     compressorThresholdSlider.setTextValueSuffix("dB");
-    //Compressor Threshold Slider Colours
-    compressorThresholdSlider.setColour(0x1001311, juce::Colour(0x8f87cefa));
-    compressorThresholdSlider.setColour(0x1001312, juce::Colour(0xdd111111));
-    compressorThresholdSlider.setColour(0x1001500, juce::Colour(0x23ffffff));
-    compressorThresholdSlider.setColour(0x1001300, juce::Colour(0xffdd00ff));
-    compressorThresholdSlider.setColour(0x1001400, juce::Colour(0xffff88ff));
-    compressorThresholdSlider.setColour(0x1001700, juce::Colour(0x9fdd00ff));
+
+    //Compressor Lookahead Slider (Horizontal slider under the compressor knobs)
+    compressorLookaheadSlider.setSliderStyle(juce::Slider::SliderStyle::LinearHorizontal);
+    compressorLookaheadSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 70, 20);
+    compressorLookaheadSlider.setTextValueSuffix("ms");
+
+    //Detector, Knee and Link Amount Sliders (Bars with the value written inside, in a row under the lookahead)
+    for (auto* bar : { &compressorRmsWindowSlider, &compressorKneeSlider, &compressorLinkAmountSlider })
+        bar->setSliderStyle(juce::Slider::SliderStyle::LinearBar);
+    compressorRmsWindowSlider.setTextValueSuffix(" ms RMS");
+    compressorKneeSlider.setTextValueSuffix(" dB Knee");
+    compressorLinkAmountSlider.setTextValueSuffix(" % Link"); //Used when the link button is on
+
+    //Sidechain Highpass Slider (Bar next to the sidechain buttons, only used while the highpass is on)
+    compressorSidechainFrequencySlider.setSliderStyle(juce::Slider::SliderStyle::LinearBar);
+    compressorSidechainFrequencySlider.setTextValueSuffix(" Hz Key HP");
+    compressorSidechainHighpassButton.onClick = [this] //The highpass of the key is only in the broadband compressor, the multiband one splits the key with its crossovers
+    {
+        compressorSidechainHighpassButton.setEnabled(! compressorMultibandButton.getToggleState());
+        compressorSidechainFrequencySlider.setEnabled(compressorSidechainHighpassButton.getToggleState() && ! compressorMultibandButton.getToggleState());
+    };
+    compressorMultibandButton.onClick = [this] { compressorSidechainHighpassButton.onClick(); };
+
+    //Multiband Compressor Sliders (Bars with the value written inside, in two rows under the detector)
+    for (auto* bar : { &compressorCrossoverLowSlider, &compressorCrossoverMidSlider, &compressorCrossoverHighSlider,
+                       &compressorBand1ThresholdSlider, &compressorBand2ThresholdSlider, &compressorBand3ThresholdSlider, &compressorBand4ThresholdSlider })
+        bar->setSliderStyle(juce::Slider::SliderStyle::LinearBar);
+    compressorCrossoverLowSlider.setTextValueSuffix(" Hz");
+    compressorCrossoverMidSlider.setTextValueSuffix(" Hz");
+    compressorCrossoverHighSlider.setTextValueSuffix(" Hz");
+    compressorBand1ThresholdSlider.setTextValueSuffix(" dB");
+    compressorBand2ThresholdSlider.setTextValueSuffix(" dB");
+    compressorBand3ThresholdSlider.setTextValueSuffix(" dB");
+    compressorBand4ThresholdSlider.setTextValueSuffix(" dB");
 
     //Gain in dB Slider
     gainGainSlider.setSliderStyle(juce::Slider::SliderStyle::LinearVertical); //Sets the stule of the slider to a vertical
     gainGainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    gainGainSlider.setRange(0.0f, 20.0f, 1.1f);
-    gainGainSlider.setValue(audioProcessor.compressorRelease);
     gainGainSlider.setTextValueSuffix("dB");
-    //Gain in dB Slider Colours
-    gainGainSlider.setColour(0x1001200, juce::Colour(0xdd111111)); //Background (rotarySliderFillColourId = 0x1001200)
-    gainGainSlider.setColour(0x1001310, juce::Colour(0x8f87cefa)); //Track (rotarySliderOutlineColourId = 0x1001312)
-    gainGainSlider.setColour(0x1001500, juce::Colour(0x23ffffff)); //Textbox Backround (textBoxBackgroundColourId = 0x1001500)
-    gainGainSlider.setColour(0x1001300, juce::Colour(0xffdd00ff)); //Knob (thumbColourId = 0x1001300)
-    gainGainSlider.setColour(0x1001400, juce::Colour(0xffff88ff)); //Text (textBoxTextColourId = 0x1001400)
-    gainGainSlider.setColour(0x1001600, juce::Colour(0x9a8414ff)); //Text Highlight (textBoxHighlightColourId = 0x1001600)
-    gainGainSlider.setColour(0x1001700, juce::Colour(0x9fdd00ff)); //Textbox Border (textBoxOutlineColourId = 0x1001700)
 
     //==========================================================LABELS==============================================================\\
 
     //Filter Frequency Label
     filterFrequencyLabel.setText("Frequency", juce::dontSendNotification); //Sets the text of the label
     filterFrequencyLabel.setJustificationType(juce::Justification::centredBottom); //Positions the text at the centre bottom of the (transparent) box
-    filterFrequencyLabel.attachToComponent(&filterFrequencySlider, false); //Attaches the label to the top of the slider
-    filterFrequencyLabel.setColour(0x1000281, juce::Colour(0xffff88ff)); //Sets the colour of the text (0x1000281)
+    filterFrequencyLabel.attachToComponent(&filterFrequencySlider, false); //Attaches the label to the top of the slider (The colour of the text comes from MultiPluginLookAndFeel)
     //Filter Resonance Label
     filterResonanceLabel.setText("Resonance", juce::dontSendNotification);
     filterResonanceLabel.setJustificationType(juce::Justification::centredBottom);
     filterResonanceLabel.attachToComponent(&filterResonanceSlider, false);
-    filterResonanceLabel.setColour(0x1000281, juce::Colour(0xffff88ff));
     //Compressor Attack Label
     compressorAttackLabel.setText("Attack", juce::dontSendNotification);
     compressorAttackLabel.setJustificationType(juce::Justification::centredBottom);
     compressorAttackLabel.attachToComponent(&compressorAttackSlider, false);
-    compressorAttackLabel.setColour(0x1000281, juce::Colour(0xffff88ff));
     //Compressor Ratio Label
     compressorRatioLabel.setText("Ratio", juce::dontSendNotification);
     compressorRatioLabel.setJustificationType(juce::Justification::centredBottom);
     compressorRatioLabel.attachToComponent(&compressorRatioSlider, false);
-    compressorRatioLabel.setColour(0x1000281, juce::Colour(0xffff88ff));
     //Compressor Release Label
     compressorReleaseLabel.setText("Release", juce::dontSendNotification);
     compressorReleaseLabel.setJustificationType(juce::Justification::centredBottom);
     compressorReleaseLabel.attachToComponent(&compressorReleaseSlider, false);
-    compressorReleaseLabel.setColour(0x1000281, juce::Colour(0xffff88ff));
     //Compressor Threshhold Label
     compressorThresholdLabel.setText("Threshold", juce::dontSendNotification);
     compressorThresholdLabel.setJustificationType(juce::Justification::centredBottom);
     compressorThresholdLabel.attachToComponent(&compressorThresholdSlider, false);
-    compressorThresholdLabel.setColour(0x1000281, juce::Colour(0xffff88ff));
+    //Compressor Lookahead Label
+    compressorLookaheadLabel.setText("Lookahead", juce::dontSendNotification);
+    compressorLookaheadLabel.setJustificationType(juce::Justification::centredRight);
+    compressorLookaheadLabel.attachToComponent(&compressorLookaheadSlider, true); //Attaches the label to the left of the slider
     //Gain Label
     gainGainLabel.setText("Gain", juce::dontSendNotification);
     gainGainLabel.setJustificationType(juce::Justification::centredTop);
     gainGainLabel.attachToComponent(&gainGainSlider, false);
-    gainGainLabel.setColour(0x1000281, juce::Colour(0xffff88ff));
 
     //==========================================================LISTENERS==============================================================\\
-    //(This section is dedicated to connecting the UI elements to the variables for the processing
+    //(This section is dedicated to connecting the UI elements to the parameters for the processing
 
     //Comboboxes
     pluginTypeMenu.addListener(this); //Plugin Type Menu
     filterTypeMenu.addListener(this); //Filter Type Menu
+    filterTopologyMenu.addListener(this); //Topology Menu
+    compressorDetectorMenu.addListener(this); //Detector Menu
     //Filter Sliders
     filterFrequencySlider.addListener(this); //Frequency Slider
     filterResonanceSlider.addListener(this); //Resonance Slider
@@ -192,15 +228,80 @@ MultiPluginAudioProcessorEditor::MultiPluginAudioProcessorEditor (MultiPluginAud
     compressorRatioSlider.addListener(this); //Ratio Slider
     compressorReleaseSlider.addListener(this); //Release Slider
     compressorThresholdSlider.addListener(this); //Threshold Slider
+    compressorLookaheadSlider.addListener(this); //Lookahead Slider
     //Gain
     gainGainSlider.addListener(this);
 
+    //Parameter attachments (Connect the UI elements to the parameters of the processor. They are created after the listeners and the
+    //combobox items, so a value that differs from the initial state of an element also updates its colours and the visibility of the
+    //elements. A value equal to the initial state sends no change, so the menus and buttons are updated once after the attachments)
+    using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    pluginTypeAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::pluginType, pluginTypeMenu); //Plugin Type Menu
+    filterTypeAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterType, filterTypeMenu); //Filter Type Menu
+    filterSlopeAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterSlope, filterSlopeMenu); //Slope Menu
+    filterTopologyAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterTopology, filterTopologyMenu); //Topology Menu
+    filterOversamplingAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterOversampling, filterOversamplingMenu); //Oversampling Factor Menu
+    filterOversamplingTypeAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterOversamplingType, filterOversamplingTypeMenu); //Oversampling Type Menu
+    filterFrequencyAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterFrequency, filterFrequencySlider); //Frequency Slider
+    filterResonanceAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterResonance, filterResonanceSlider); //Resonance Slider
+    filterLfoShapeAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterLfoShape, filterLfoShapeMenu); //LFO Shape Menu
+    filterLfoRateAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterLfoRate, filterLfoRateSlider); //LFO Rate Slider
+    filterLfoDivisionAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterLfoDivision, filterLfoDivisionMenu); //LFO Division Menu
+    filterLfoCutoffAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterLfoCutoff, filterLfoCutoffSlider); //LFO Depth Sliders
+    filterLfoResonanceAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterLfoResonance, filterLfoResonanceSlider);
+    filterEnvelopeAttackAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterEnvelopeAttack, filterEnvelopeAttackSlider); //Envelope Sliders
+    filterEnvelopeReleaseAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterEnvelopeRelease, filterEnvelopeReleaseSlider);
+    filterEnvelopeCutoffAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterEnvelopeCutoff, filterEnvelopeCutoffSlider);
+    filterEnvelopeResonanceAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::filterEnvelopeResonance, filterEnvelopeResonanceSlider);
+    filterControlRateAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::filterControlRate, filterControlRateMenu); //Control Rate Menu
+    compressorAttackAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorAttack, compressorAttackSlider); //Attack Slider
+    compressorRatioAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorRatio, compressorRatioSlider); //Ratio Slider
+    compressorReleaseAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorRelease, compressorReleaseSlider); //Release Slider
+    compressorThresholdAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorThreshold, compressorThresholdSlider); //Threshold Slider
+    compressorLookaheadAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorLookahead, compressorLookaheadSlider); //Lookahead Slider
+    compressorDetectorAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::compressorDetector, compressorDetectorMenu); //Detector Menu
+    compressorRmsWindowAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorRmsWindow, compressorRmsWindowSlider); //RMS Window Slider
+    compressorKneeAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorKnee, compressorKneeSlider); //Knee Slider
+    compressorLinkAmountAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorLinkAmount, compressorLinkAmountSlider); //Link Amount Slider
+    compressorSidechainFrequencyAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorSidechainFrequency, compressorSidechainFrequencySlider); //Sidechain Highpass Slider
+    gainGainAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::gainGain, gainGainSlider); //Gain Slider
+    using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+    compressorLinkAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::compressorLink, compressorLinkButton); //Link Button
+    chainOrderAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::chainOrder, chainOrderMenu); //Chain Order Menu
+    chainFilterAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::chainFilter, chainFilterButton); //Chain Filter Button
+    chainCompressorAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::chainCompressor, chainCompressorButton); //Chain Compressor Button
+    chainGainAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::chainGain, chainGainButton); //Chain Gain Button
+    compressorSidechainAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::compressorSidechain, compressorSidechainButton); //Sidechain Button
+    compressorSidechainHighpassAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::compressorSidechainHighpass, compressorSidechainHighpassButton); //Sidechain Highpass Button
+    filterLfoSyncAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::filterLfoSync, filterLfoSyncButton); //LFO Sync Button
+    filterLfoSyncButton.onClick(); //The attachment only clicks the button when the value differs from its initial state
+    compressorMultibandAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParameterIDs::compressorMultiband, compressorMultibandButton); //Multiband Button
+    compressorSidechainHighpassButton.onClick(); //Same as the LFO sync button (After both attachments)
+    compressorBandsAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.parameters, ParameterIDs::compressorBands, compressorBandsMenu); //Bands Menu
+    compressorCrossoverLowAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorCrossoverLow, compressorCrossoverLowSlider); //Low Crossover Slider
+    compressorCrossoverMidAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorCrossoverMid, compressorCrossoverMidSlider); //Mid Crossover Slider
+    compressorCrossoverHighAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorCrossoverHigh, compressorCrossoverHighSlider); //High Crossover Slider
+    compressorBand1ThresholdAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorBand1Threshold, compressorBand1ThresholdSlider); //Band Threshold Sliders
+    compressorBand2ThresholdAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorBand2Threshold, compressorBand2ThresholdSlider);
+    compressorBand3ThresholdAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorBand3Threshold, compressorBand3ThresholdSlider);
+    compressorBand4ThresholdAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParameterIDs::compressorBand4Threshold, compressorBand4ThresholdSlider);
+    //The attachments only change the selection of a menu when the value differs from the preselected item, so the menus are updated once here
+    comboBoxChanged(&pluginTypeMenu); //Shows the elements of the mode (And enables the spectrum analyzer in the filter mode)
+    comboBoxChanged(&filterTypeMenu); //Colours of the filter type menu
+    comboBoxChanged(&filterTopologyMenu); //Slope menu
+    comboBoxChanged(&compressorDetectorMenu); //RMS window slider
+
     //Making elements visible
     addAndMakeVisible(&pluginTypeMenu);
+    addAndMakeVisible(&levelMeter);
+   #if MULTIPLUGIN_PROFILING
+    addAndMakeVisible(&profilerView);
+   #endif
+
+    //Meters (The processor only measures the levels while the editor is open)
+    audioProcessor.setMeteringEnabled(true);
 
-    //Effects (Sets the parameters for the glow effect. This effect is used on components to highlight them when in use)
-    glowEffect.setGlowProperties(5, juce::Colour(0x1fff88ff));
-    
     /*This section does not contain the addAndMakeVisible function for the sliders and other certain elements as these elements
     are defined in the if loop of pluginType combobox to make different sliders visible for each option.Lables do not need to
     have this function used in order to get visible as we have attached them to their respective sliders.*/
@@ -210,6 +311,9 @@ MultiPluginAudioProcessorEditor::MultiPluginAudioProcessorEditor (MultiPluginAud
 
 MultiPluginAudioProcessorEditor::~MultiPluginAudioProcessorEditor()
 {
+    audioProcessor.setMeteringEnabled(false);
+    audioProcessor.setAnalyzerEnabled(false);
+    setLookAndFeel(nullptr);
 }
 
 //==============================================================================
@@ -221,29 +325,80 @@ void MultiPluginAudioProcessorEditor::paint (juce::Graphics& g)
 
 void MultiPluginAudioProcessorEditor::resized()
 {
-    setSize(400, 400); //Keeps window size unchangeable
+    //Keeps window size unchangeable (The chain mode shows the filter and the compressor side by side so its window is wider,
+    //and the window is taller when the detector, sidechain and multiband controls under the compressor or the spectrum analyzer are shown)
+    const auto x = pluginTypeMenu.getSelectedId() == 3 ? chainOffset : 0; //Position of the compressor section
+    const auto y = pluginTypeMenu.getSelectedId() == 1 ? analyzerOffset : 0; //Room for the spectrum analyzer under the modulation
+    setSize(400 + x + meterWidth, 620 + y + profilerHeight);
 
    //Sets positions of the UI elements
     //Combobox
     pluginTypeMenu.setBounds(100, 10, 200, 25); //Plugin Type Menu
-    filterTypeMenu.setBounds(100, 290, 200, 25); //Filter Type Menu
+    filterTypeMenu.setBounds(20, 290, 115, 25); //Filter Type Menu
+    filterSlopeMenu.setBounds(140, 290, 110, 25); //Slope Menu
+    filterTopologyMenu.setBounds(255, 290, 125, 25); //Topology Menu
+    filterOversamplingMenu.setBounds(100, 330, 130, 25); //Oversampling Factor Menu
+    filterOversamplingTypeMenu.setBounds(240, 330, 60, 25); //Oversampling Type Menu
+    filterLfoShapeMenu.setBounds(20, 365, 85, 25); //LFO Shape Menu
+    filterLfoDivisionMenu.setBounds(280, 365, 100, 25); //LFO Division Menu
+    filterControlRateMenu.setBounds(290, 400, 90, 25); //Control Rate Menu
+    chainOrderMenu.setBounds(100 + chainOffset, 10, 200, 25); //Chain Order Menu
     //Filter
     filterFrequencySlider.setBounds(20, 80, 170, 170); //Frequency Slider
     filterResonanceSlider.setBounds(210, 80, 170, 170); //Resonance Slider
+    //Filter Modulation
+    filterLfoRateSlider.setBounds(175, 365, 100, 25); //LFO Rate Slider
+    filterLfoCutoffSlider.setBounds(20, 400, 130, 25); //LFO Depth Sliders
+    filterLfoResonanceSlider.setBounds(155, 400, 130, 25);
+    filterEnvelopeAttackSlider.setBounds(20, 435, 85, 25); //Envelope Sliders
+    filterEnvelopeReleaseSlider.setBounds(110, 435, 85, 25);
+    filterEnvelopeCutoffSlider.setBounds(200, 435, 85, 25);
+    filterEnvelopeResonanceSlider.setBounds(290, 435, 90, 25);
     //Compressor
-    compressorAttackSlider.setBounds(80, 240, 140, 140); //Compressor Attack
-    compressorRatioSlider.setBounds(80, 60, 140, 140); //Compressor Ratio
-    compressorReleaseSlider.setBounds(240, 240, 140, 140); //Compressor Release
-    compressorThresholdSlider.setBounds(240, 60, 140, 140); //Compressor Threshold
+    compressorAttackSlider.setBounds(80 + x, 240, 140, 140); //Compressor Attack
+    compressorRatioSlider.setBounds(80 + x, 60, 140, 140); //Compressor Ratio
+    compressorReleaseSlider.setBounds(240 + x, 240, 140, 140); //Compressor Release
+    compressorThresholdSlider.setBounds(240 + x, 60, 140, 140); //Compressor Threshold
+    compressorLookaheadSlider.setBounds(100 + x, 400, 280, 25); //Compressor Lookahead (The label is on its left)
+    compressorDetectorMenu.setBounds(20 + x, 440, 80, 25); //Detector Menu
+    compressorRmsWindowSlider.setBounds(105 + x, 440, 90, 25); //RMS Window, Knee and Link Amount Sliders
+    compressorKneeSlider.setBounds(200 + x, 440, 85, 25);
+    compressorLinkAmountSlider.setBounds(290 + x, 440, 85, 25);
+    compressorSidechainFrequencySlider.setBounds(225 + x, 475, 150, 25); //Sidechain Highpass Slider
+    //Multiband Compressor
+    compressorBandsMenu.setBounds(130 + x, 510, 100, 25); //Bands Menu
+    compressorCrossoverLowSlider.setBounds(20 + x, 545, 115, 25); //Crossover Sliders
+    compressorCrossoverMidSlider.setBounds(140 + x, 545, 115, 25);
+    compressorCrossoverHighSlider.setBounds(260 + x, 545, 115, 25);
+    compressorBand1ThresholdSlider.setBounds(20 + x, 580, 85, 25); //Band Threshold Sliders
+    compressorBand2ThresholdSlider.setBounds(110 + x, 580, 85, 25);
+    compressorBand3ThresholdSlider.setBounds(200 + x, 580, 85, 25);
+    compressorBand4ThresholdSlider.setBounds(290 + x, 580, 85, 25);
     //Gain
-    gainGainSlider.setBounds(20, 80, 60, 280); //Gain Slider
+    gainGainSlider.setBounds(20 + x, 80, 60, 280); //Gain Slider
+    //Buttons
+    compressorLinkButton.setBounds(310 + x, 10, 80, 25); //Compressor Link Button
+    filterLfoSyncButton.setBounds(110, 365, 60, 25); //LFO Sync Button
+    compressorSidechainButton.setBounds(20 + x, 475, 100, 25); //Sidechain Button
+    compressorSidechainHighpassButton.setBounds(130 + x, 475, 90, 25); //Sidechain Highpass Button
+    compressorMultibandButton.setBounds(20 + x, 510, 100, 25); //Multiband Button
+    chainFilterButton.setBounds(10, 10, 80, 25); //Chain Filter Button
+    chainCompressorButton.setBounds(10 + chainOffset, 10, 90, 25); //Chain Compressor Button
+    chainGainButton.setBounds(10 + chainOffset, 365, 80, 25); //Chain Gain Button
+    //Spectrum Analyzer
+    spectrumAnalyzer.setBounds(20, 370 + analyzerOffset, 360, 230); //Under the filter section and its modulation
+    //Meters
+    levelMeter.setBounds(getWidth() - meterWidth, 10, meterWidth - 10, getHeight() - profilerHeight - 20); //Level Meters (Right edge of the window)
+   #if MULTIPLUGIN_PROFILING
+    //Profiler
+    profilerView.setBounds(10, getHeight() - profilerHeight, getWidth() - 20, profilerHeight - 10); //Bottom of the window
+   #endif
 }
 
 void MultiPluginAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
 {
-    if (slider == &filterFrequencySlider) { //This if statement checks which slider changed and conencts it to the respective processor value
-        audioProcessor.filterFrequency = slider->getValue(); //changes the value of the processor when the value is changed
-        
+    //The values of the processor are changed by the parameter attachments, this function only changes the look of the sliders
+    if (slider == &filterFrequencySlider) { //This if statement checks which slider changed
         if (slider->getValue() <= 60) { //This if statement changes the colour of a part of a slider depending on the value selected
             filterFrequencySlider.setColour(0x1001311, juce::Colour(0x2fff3252)); //20 - 60 Hz (Sub-Bass)
         }
@@ -265,100 +420,163 @@ void MultiPluginAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
         else {
             filterFrequencySlider.setColour(0x1001311, juce::Colour(0xffff3252)); //6000 - 20000 Hz (Brilliance)
         }
-
-        if (filterFrequencySlider.isMouseButtonDown(true) == true) { //Function that make the component glow when the mouse 
-            filterFrequencySlider.setComponentEffect(&glowEffect);
-        }
-    }
-    else if (slider == &filterResonanceSlider) {
-        audioProcessor.filterResonance = slider->getValue(); //Resonance Slider
-
-        if (filterResonanceSlider.isMouseButtonDown(true) == true) {
-            filterResonanceSlider.setComponentEffect(&glowEffect);
-        }
-    }
-    else if (slider == &compressorAttackSlider) {
-        audioProcessor.compressorAttack = slider->getValue(); //Attack Slider
-
-        if (compressorAttackSlider.isMouseButtonDown(true) == true) {
-            compressorAttackSlider.setComponentEffect(&glowEffect);
-        }
-    }
-    else if (slider == &compressorRatioSlider) {
-        audioProcessor.compressorRatio = slider->getValue(); //Ratio Slider
-
-        if (compressorRatioSlider.isMouseButtonDown(true) == true) {
-            compressorRatioSlider.setComponentEffect(&glowEffect);
-        }
-    }
-    else if (slider == &compressorReleaseSlider) {
-        audioProcessor.compressorRelease = slider->getValue(); //Release Slider
-
-        if (compressorReleaseSlider.isMouseButtonDown(true) == true) {
-            compressorReleaseSlider.setComponentEffect(&glowEffect);
-        }
-    }
-    else if (slider == &compressorThresholdSlider) {
-        audioProcessor.compressorThreshold = slider->getValue(); //Threshold Slider
-
-        if (compressorThresholdSlider.isMouseButtonDown(true) == true) {
-            compressorThresholdSlider.setComponentEffect(&glowEffect);
-        }
     }
-    else if (slider == &gainGainSlider) {
-        audioProcessor.gainGain = slider->getValue(); //Gain Slider
+}
 
-        if (gainGainSlider.isMouseButtonDown(true) == true) {
-            gainGainSlider.setComponentEffect(&glowEffect);
-        }
-    }
+void MultiPluginAudioProcessorEditor::sliderDragStarted(juce::Slider* slider) //Function that is initiated when the user starts draging the slider
+{
+    MultiPluginLookAndFeel::setGlowing(*slider, true); //The look and feel draws the glow of the slider from its image cache, only the slider is repainted
 }
 
 void MultiPluginAudioProcessorEditor::sliderDragEnded(juce::Slider* slider) //Function that is initiated when the user stops draging the slider
 {
-    //In this function we make sure that every glow is deleted when the user does not react with any sliders
-    filterFrequencySlider.setComponentEffect(NULL);
-    filterResonanceSlider.setComponentEffect(NULL);
-    compressorAttackSlider.setComponentEffect(NULL);
-    compressorRatioSlider.setComponentEffect(NULL);
-    compressorReleaseSlider.setComponentEffect(NULL);
-    compressorThresholdSlider.setComponentEffect(NULL);
-    gainGainSlider.setComponentEffect(NULL);
+    MultiPluginLookAndFeel::setGlowing(*slider, false); //Removes the glow
+}
+
+void MultiPluginAudioProcessorEditor::setFilterModulationVisible(bool shouldBeVisible)
+{
+    for (auto* component : std::initializer_list<juce::Component*> { &filterLfoShapeMenu, &filterLfoSyncButton, &filterLfoRateSlider, &filterLfoDivisionMenu,
+                                                                     &filterLfoCutoffSlider, &filterLfoResonanceSlider, &filterControlRateMenu,
+                                                                     &filterEnvelopeAttackSlider, &filterEnvelopeReleaseSlider, &filterEnvelopeCutoffSlider,
+                                                                     &filterEnvelopeResonanceSlider })
+    {
+        if (shouldBeVisible)
+            addAndMakeVisible(component);
+        else
+            component->setVisible(false);
+    }
 }
 
 void MultiPluginAudioProcessorEditor::comboBoxChanged(juce::ComboBox* combobox)
 {
     if (combobox == &pluginTypeMenu) { //Plugin Type Menu
-        audioProcessor.pluginType = combobox->getSelectedId();
         if (combobox->getSelectedId() == 1) { //Filter
             //setVisible() sets the visibility of the item and setVisible(false) means that the elements are invisible so any unwanted elements are removed here
             compressorAttackSlider.setVisible(false); //Compressor Attack Slider
             compressorRatioSlider.setVisible(false); //Compressor Ratio Slider
             compressorReleaseSlider.setVisible(false); //Compressor Release Slider
             compressorThresholdSlider.setVisible(false); //Compressor Theshold Slider
+            compressorLookaheadSlider.setVisible(false); //Compressor Lookahead Slider
+            compressorDetectorMenu.setVisible(false); //Compressor Detector Menu
+            compressorRmsWindowSlider.setVisible(false); //Compressor RMS Window, Knee and Link Amount Sliders
+            compressorKneeSlider.setVisible(false);
+            compressorLinkAmountSlider.setVisible(false);
+            compressorSidechainButton.setVisible(false); //Sidechain Buttons and Highpass Slider
+            compressorSidechainHighpassButton.setVisible(false);
+            compressorSidechainFrequencySlider.setVisible(false);
+            compressorMultibandButton.setVisible(false); //Multiband Compressor Button
+            compressorBandsMenu.setVisible(false); //Multiband Compressor Bands Menu
+            compressorCrossoverLowSlider.setVisible(false); //Multiband Compressor Crossover Sliders
+            compressorCrossoverMidSlider.setVisible(false);
+            compressorCrossoverHighSlider.setVisible(false);
+            compressorBand1ThresholdSlider.setVisible(false); //Multiband Compressor Band Threshold Sliders
+            compressorBand2ThresholdSlider.setVisible(false);
+            compressorBand3ThresholdSlider.setVisible(false);
+            compressorBand4ThresholdSlider.setVisible(false);
             gainGainSlider.setVisible(false); //Gain Slider
+            compressorLinkButton.setVisible(false); //Compressor Link Button
+            chainOrderMenu.setVisible(false); //Chain Order Menu
+            chainFilterButton.setVisible(false); //Chain Filter Button
+            chainCompressorButton.setVisible(false); //Chain Compressor Button
+            chainGainButton.setVisible(false); //Chain Gain Button
 
             //With the addAndMakeVisible function we create and make visible the elements that are used in the current state of the plugin
             addAndMakeVisible(&filterFrequencySlider); //Frequency Slider
             addAndMakeVisible(&filterResonanceSlider); //Resonance Slider
             addAndMakeVisible(&filterTypeMenu); //Filter Type Menu
+            addAndMakeVisible(&filterSlopeMenu); //Slope Menu
+            addAndMakeVisible(&filterTopologyMenu); //Topology Menu
+            addAndMakeVisible(&filterOversamplingMenu); //Oversampling Factor Menu
+            addAndMakeVisible(&filterOversamplingTypeMenu); //Oversampling Type Menu
+            setFilterModulationVisible(true); //LFO and Envelope Follower
+            addAndMakeVisible(&spectrumAnalyzer); //Spectrum Analyzer
+            audioProcessor.setAnalyzerEnabled(true); //The processor sends its output to the analyzer
         }
         else if (combobox->getSelectedId() == 2) { //Compressor
             filterFrequencySlider.setVisible(false);
             filterResonanceSlider.setVisible(false);
             filterTypeMenu.setVisible(false);
+            filterSlopeMenu.setVisible(false);
+            filterTopologyMenu.setVisible(false);
+            filterOversamplingMenu.setVisible(false);
+            filterOversamplingTypeMenu.setVisible(false);
+            setFilterModulationVisible(false);
+            chainOrderMenu.setVisible(false);
+            chainFilterButton.setVisible(false);
+            chainCompressorButton.setVisible(false);
+            chainGainButton.setVisible(false);
+            spectrumAnalyzer.setVisible(false);
+            audioProcessor.setAnalyzerEnabled(false);
 
             //Making elements visible
             addAndMakeVisible(&compressorAttackSlider); //Attack Slider
             addAndMakeVisible(&compressorRatioSlider); //Ratio Slider
             addAndMakeVisible(&compressorReleaseSlider); //Release Slider
             addAndMakeVisible(&compressorThresholdSlider); //Threshold Slider
+            addAndMakeVisible(&compressorLookaheadSlider); //Lookahead Slider
+            addAndMakeVisible(&compressorDetectorMenu); //Detector Menu
+            addAndMakeVisible(&compressorRmsWindowSlider); //RMS Window, Knee and Link Amount Sliders
+            addAndMakeVisible(&compressorKneeSlider);
+            addAndMakeVisible(&compressorLinkAmountSlider);
+            addAndMakeVisible(&compressorSidechainButton); //Sidechain Buttons and Highpass Slider
+            addAndMakeVisible(&compressorSidechainHighpassButton);
+            addAndMakeVisible(&compressorSidechainFrequencySlider);
+            addAndMakeVisible(&compressorMultibandButton); //Multiband Button
+            addAndMakeVisible(&compressorBandsMenu); //Bands Menu
+            addAndMakeVisible(&compressorCrossoverLowSlider); //Crossover Sliders
+            addAndMakeVisible(&compressorCrossoverMidSlider);
+            addAndMakeVisible(&compressorCrossoverHighSlider);
+            addAndMakeVisible(&compressorBand1ThresholdSlider); //Band Threshold Sliders
+            addAndMakeVisible(&compressorBand2ThresholdSlider);
+            addAndMakeVisible(&compressorBand3ThresholdSlider);
+            addAndMakeVisible(&compressorBand4ThresholdSlider);
             addAndMakeVisible(&gainGainSlider); //Gain Slider
+            addAndMakeVisible(&compressorLinkButton); //Link Button
         }
+        else if (combobox->getSelectedId() == 3) { //Chain (Every element of the filter and of the compressor, with the chain order and the stage buttons)
+            spectrumAnalyzer.setVisible(false); //The analyzer is only in the filter mode
+            audioProcessor.setAnalyzerEnabled(false);
+
+            addAndMakeVisible(&filterFrequencySlider); //Frequency Slider
+            addAndMakeVisible(&filterResonanceSlider); //Resonance Slider
+            addAndMakeVisible(&filterTypeMenu); //Filter Type Menu
+            addAndMakeVisible(&filterSlopeMenu); //Slope Menu
+            addAndMakeVisible(&filterTopologyMenu); //Topology Menu
+            addAndMakeVisible(&filterOversamplingMenu); //Oversampling Factor Menu
+            addAndMakeVisible(&filterOversamplingTypeMenu); //Oversampling Type Menu
+            setFilterModulationVisible(true); //LFO and Envelope Follower
+            addAndMakeVisible(&compressorAttackSlider); //Attack Slider
+            addAndMakeVisible(&compressorRatioSlider); //Ratio Slider
+            addAndMakeVisible(&compressorReleaseSlider); //Release Slider
+            addAndMakeVisible(&compressorThresholdSlider); //Threshold Slider
+            addAndMakeVisible(&compressorLookaheadSlider); //Lookahead Slider
+            addAndMakeVisible(&compressorDetectorMenu); //Detector Menu
+            addAndMakeVisible(&compressorRmsWindowSlider); //RMS Window, Knee and Link Amount Sliders
+            addAndMakeVisible(&compressorKneeSlider);
+            addAndMakeVisible(&compressorLinkAmountSlider);
+            addAndMakeVisible(&compressorSidechainButton); //Sidechain Buttons and Highpass Slider
+            addAndMakeVisible(&compressorSidechainHighpassButton);
+            addAndMakeVisible(&compressorSidechainFrequencySlider);
+            addAndMakeVisible(&compressorMultibandButton); //Multiband Button
+            addAndMakeVisible(&compressorBandsMenu); //Bands Menu
+            addAndMakeVisible(&compressorCrossoverLowSlider); //Crossover Sliders
+            addAndMakeVisible(&compressorCrossoverMidSlider);
+            addAndMakeVisible(&compressorCrossoverHighSlider);
+            addAndMakeVisible(&compressorBand1ThresholdSlider); //Band Threshold Sliders
+            addAndMakeVisible(&compressorBand2ThresholdSlider);
+            addAndMakeVisible(&compressorBand3ThresholdSlider);
+            addAndMakeVisible(&compressorBand4ThresholdSlider);
+            addAndMakeVisible(&gainGainSlider); //Gain Slider
+            addAndMakeVisible(&compressorLinkButton); //Link Button
+            addAndMakeVisible(&chainOrderMenu); //Chain Order Menu
+            addAndMakeVisible(&chainFilterButton); //Chain Filter Button
+            addAndMakeVisible(&chainCompressorButton); //Chain Compressor Button
+            addAndMakeVisible(&chainGainButton); //Chain Gain Button
+        }
+
+        resized(); //The chain and the filter modes change the size of the window and the position of the compressor section and of the analyzer
     }
     else if (combobox == &filterTypeMenu) { //Filter Type Menu
-        audioProcessor.filterType = combobox->getSelectedId();
-
         if (combobox->getSelectedId() == 1) { // If statement that changes the colour depending on the filter type
             filterTypeMenu.setColour(0x1000a00, juce::Colour(0xffff3252)); //Text
             filterTypeMenu.setColour(0x1000e00, juce::Colour(0xffff3252)); //Arrow
@@ -375,4 +593,10 @@ void MultiPluginAudioProcessorEditor::comboBoxChanged(juce::ComboBox* combobox)
             filterTypeMenu.setColour(0x1000c00, juce::Colour(0xff32ff52)); //Outline
         }
     }
-}
\ No newline at end of file
+    else if (combobox == &filterTopologyMenu) { //Topology Menu
+        filterSlopeMenu.setEnabled(combobox->getSelectedId() == 1); //Only the state variable filter has a choice of slope
+    }
+    else if (combobox == &compressorDetectorMenu) { //Detector Menu
+        compressorRmsWindowSlider.setEnabled(combobox->getSelectedId() == 2); //Only the RMS detector has a window
+    }
+}
\ No newline at end of file
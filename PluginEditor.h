@@ -13,6 +13,10 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "LevelMeter.h"
+#include "SpectrumAnalyzer.h"
+#include "ProfilerView.h"
+#include "MultiPluginLookAndFeel.h"
 
 //==============================================================================
 /**
@@ -30,6 +34,7 @@ public:
     void resized() override;
 
     void sliderValueChanged(juce::Slider* slider) override; //Overriding slider listener function from the class Slider::Listener
+    void sliderDragStarted(juce::Slider* slider) override; //Overriding slider listener function from the class Slider::Listener
     void sliderDragEnded(juce::Slider* slider) override; //Overriding slider listener function from the class Slider::Listener
     void comboBoxChanged(juce::ComboBox* combobox) override; //Overriding combobox listener function from the class ComboBox::Listener
     
@@ -39,19 +44,72 @@ private:
     // access the processor object that created it.
     MultiPluginAudioProcessor& audioProcessor;
 
+    void setFilterModulationVisible(bool shouldBeVisible); //Shows or hides every element of the LFO and the envelope follower (They are shown with the filter section)
+
+    juce::SharedResourcePointer<MultiPluginLookAndFeel> lookAndFeel; //Look and feel of every editor (Declared before the UI elements so it is deleted after them)
+
+    static constexpr int chainOffset = 380; //In chain mode the window is wider and the compressor section is moved to the right of the filter section
+    static constexpr int meterWidth = 70; //Strip on the right of the window for the level meters
+    static constexpr int analyzerOffset = 100; //In filter mode the window is taller, the spectrum analyzer is under the modulation of the filter
+   #if MULTIPLUGIN_PROFILING
+    static constexpr int profilerHeight = 70; //Strip at the bottom of the window for the profiler
+   #else
+    static constexpr int profilerHeight = 0;
+   #endif
+
     //Comboboxes
     juce::ComboBox filterTypeMenu; //Filter Menu
     juce::ComboBox pluginTypeMenu; //Plugin Menu
+    juce::ComboBox filterSlopeMenu; //Slope Menu
+    juce::ComboBox filterTopologyMenu; //Topology Menu
+    juce::ComboBox filterOversamplingMenu; //Oversampling Factor Menu
+    juce::ComboBox filterOversamplingTypeMenu; //Oversampling Type Menu
+    juce::ComboBox chainOrderMenu; //Chain Order Menu
+    juce::ComboBox compressorBandsMenu; //Multiband Compressor Bands Menu
+    juce::ComboBox compressorDetectorMenu; //Compressor Detector Menu
+    juce::ComboBox filterLfoShapeMenu; //LFO Shape Menu
+    juce::ComboBox filterLfoDivisionMenu; //LFO Division Menu
+    juce::ComboBox filterControlRateMenu; //Modulation Control Rate Menu
     //Filter
     juce::Slider filterFrequencySlider; //Frequency
     juce::Slider filterResonanceSlider; //Resonance
+    //Filter Modulation
+    juce::Slider filterLfoRateSlider; //LFO Rate
+    juce::Slider filterLfoCutoffSlider; //LFO Frequency Depth
+    juce::Slider filterLfoResonanceSlider; //LFO Resonance Depth
+    juce::Slider filterEnvelopeAttackSlider; //Envelope Attack
+    juce::Slider filterEnvelopeReleaseSlider; //Envelope Release
+    juce::Slider filterEnvelopeCutoffSlider; //Envelope Frequency Depth
+    juce::Slider filterEnvelopeResonanceSlider; //Envelope Resonance Depth
     //Compressor
     juce::Slider compressorAttackSlider; //Attack
     juce::Slider compressorRatioSlider; //Ratio
     juce::Slider compressorReleaseSlider; // Release
     juce::Slider compressorThresholdSlider; //Threshold
+    juce::Slider compressorLookaheadSlider; //Lookahead
+    juce::Slider compressorRmsWindowSlider; //RMS Window
+    juce::Slider compressorKneeSlider; //Knee
+    juce::Slider compressorLinkAmountSlider; //Link Amount
+    juce::Slider compressorSidechainFrequencySlider; //Sidechain Highpass Frequency
+    //Multiband Compressor
+    juce::Slider compressorCrossoverLowSlider; //Low Crossover
+    juce::Slider compressorCrossoverMidSlider; //Mid Crossover
+    juce::Slider compressorCrossoverHighSlider; //High Crossover
+    juce::Slider compressorBand1ThresholdSlider; //Band 1 Threshold
+    juce::Slider compressorBand2ThresholdSlider; //Band 2 Threshold
+    juce::Slider compressorBand3ThresholdSlider; //Band 3 Threshold
+    juce::Slider compressorBand4ThresholdSlider; //Band 4 Threshold
     //Gain
     juce::Slider gainGainSlider; //Gain
+    //Buttons
+    juce::ToggleButton filterLfoSyncButton { "Sync" }; //LFO Tempo Sync On/Off
+    juce::ToggleButton compressorLinkButton { "Link" }; //Compressor Link Channels
+    juce::ToggleButton compressorMultibandButton { "Multiband" }; //Multiband Compressor On/Off
+    juce::ToggleButton compressorSidechainButton { "Sidechain" }; //External Sidechain On/Off
+    juce::ToggleButton compressorSidechainHighpassButton { "Key HP" }; //Sidechain Highpass On/Off
+    juce::ToggleButton chainFilterButton { "Filter" }; //Chain Filter Stage On/Off
+    juce::ToggleButton chainCompressorButton { "Compressor" }; //Chain Compressor Stage On/Off
+    juce::ToggleButton chainGainButton { "Gain" }; //Chain Gain Stage On/Off
     //Labels
     juce::Label filterFrequencyLabel; //Filter Frequency
     juce::Label filterResonanceLabel; //Filter Resonance
@@ -59,9 +117,63 @@ private:
     juce::Label compressorRatioLabel; //Compressor Ratio
     juce::Label compressorReleaseLabel; //Compressor Release
     juce::Label compressorThresholdLabel; //Compressor Threshold
+    juce::Label compressorLookaheadLabel; //Compressor Lookahead
     juce::Label gainGainLabel; //Gain
-    //Effects
-    juce::GlowEffect glowEffect; //Glow
+    //Meters
+    LevelMeter levelMeter { audioProcessor.getMeterFifo() }; //Input, Output and Gain Reduction
+    //Spectrum Analyzer (Filter mode only, with the response of the filter over the spectrum of the output)
+    SpectrumAnalyzer spectrumAnalyzer { audioProcessor.getAnalyzerFifo(), audioProcessor.parameters, audioProcessor };
+   #if MULTIPLUGIN_PROFILING
+    //Profiler (Load of the audio callback)
+    ProfilerView profilerView { audioProcessor.getProfiler() };
+   #endif
+    //Parameter Attachments (Declared after the UI elements so they get deleted first)
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> pluginTypeAttachment; //Plugin Type Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterTypeAttachment; //Filter Type Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterSlopeAttachment; //Slope Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterTopologyAttachment; //Topology Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterOversamplingAttachment; //Oversampling Factor Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterOversamplingTypeAttachment; //Oversampling Type Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterFrequencyAttachment; //Frequency
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterResonanceAttachment; //Resonance
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterLfoShapeAttachment; //LFO Shape Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterLfoRateAttachment; //LFO Rate
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> filterLfoSyncAttachment; //LFO Sync
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterLfoDivisionAttachment; //LFO Division Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterLfoCutoffAttachment; //LFO Frequency Depth
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterLfoResonanceAttachment; //LFO Resonance Depth
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterEnvelopeAttackAttachment; //Envelope Attack
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterEnvelopeReleaseAttachment; //Envelope Release
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterEnvelopeCutoffAttachment; //Envelope Frequency Depth
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterEnvelopeResonanceAttachment; //Envelope Resonance Depth
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterControlRateAttachment; //Control Rate Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorAttackAttachment; //Attack
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorRatioAttachment; //Ratio
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorReleaseAttachment; //Release
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorThresholdAttachment; //Threshold
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorLookaheadAttachment; //Lookahead
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> compressorDetectorAttachment; //Detector Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorRmsWindowAttachment; //RMS Window
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorKneeAttachment; //Knee
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorLinkAmountAttachment; //Link Amount
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> compressorSidechainAttachment; //Sidechain On/Off
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> compressorSidechainHighpassAttachment; //Sidechain Highpass On/Off
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorSidechainFrequencyAttachment; //Sidechain Highpass Frequency
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> compressorMultibandAttachment; //Multiband On/Off
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> compressorBandsAttachment; //Bands Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorCrossoverLowAttachment; //Low Crossover
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorCrossoverMidAttachment; //Mid Crossover
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorCrossoverHighAttachment; //High Crossover
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorBand1ThresholdAttachment; //Band 1 Threshold
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorBand2ThresholdAttachment; //Band 2 Threshold
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorBand3ThresholdAttachment; //Band 3 Threshold
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> compressorBand4ThresholdAttachment; //Band 4 Threshold
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> gainGainAttachment; //Gain
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> compressorLinkAttachment; //Link Channels
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> chainOrderAttachment; //Chain Order Menu
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> chainFilterAttachment; //Chain Filter Stage
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> chainCompressorAttachment; //Chain Compressor Stage
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> chainGainAttachment; //Chain Gain Stage
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiPluginAudioProcessorEditor)
 };
@@ -0,0 +1,513 @@
+/*
+  ==============================================================================
+
+    This file contains the DSP engine of the plugin.
+
+    The code is the one the processor used before it was templated, so the float engine processes exactly like before.
+
+  ==============================================================================
+*/
+
+#include "PluginEngine.h"
+#include "FastMath.h"
+
+//==============================================================================
+template <typename SampleType>
+void PluginEngine<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+
+    //Preparing the oversampling of the filter (Every factor and type, so the audio thread never allocates when they change)
+    for (int order = 1; order <= maximumOversamplingOrder; ++order)
+    {
+        for (auto type : { OversamplingTypes::lowLatency, OversamplingTypes::linearPhase })
+        {
+            auto& oversampling = oversamplers[(size_t) ((order - 1) * 2 + type)];
+            oversampling = std::make_unique<juce::dsp::Oversampling<SampleType>>(spec.numChannels, (size_t) order,
+                                                                                 type == OversamplingTypes::lowLatency ? juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR
+                                                                                                                       : juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple,
+                                                                                 true, true); //Maximum quality and an integer latency that the host can compensate exactly
+            oversampling->initProcessing(spec.maximumBlockSize);
+        }
+    }
+
+    oversampler = nullptr;
+
+    //Preparing the DSP processes
+    filter.prepare({ spec.sampleRate, spec.maximumBlockSize << maximumOversamplingOrder, spec.numChannels }); //Filter (Room for the largest oversampled block)
+    ladderFilter.prepare({ spec.sampleRate, spec.maximumBlockSize << maximumOversamplingOrder, spec.numChannels }); //Ladder Filter
+    compressor.prepare(spec); //Compressor
+    multibandCompressor.prepare(spec); //Multiband Compressor
+    gain.prepare(spec); //Gain
+    modulation.prepare(spec.sampleRate); //Filter Modulation (Runs at the rate of the host, the chunks are cut before the oversampling)
+    reset();
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::release()
+{
+    for (auto& oversampling : oversamplers) //The largest allocations (The other processes are small and are reallocated by the next prepare())
+        oversampling.reset();
+
+    oversampler = nullptr;
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::reset() noexcept
+{
+    filter.reset(); //Filter
+    ladderFilter.reset(); //Ladder Filter
+    for (auto& oversampling : oversamplers) //Oversampling
+        if (oversampling != nullptr)
+            oversampling->reset();
+    compressor.reset(); //Compressor
+    multibandCompressor.reset(); //Multiband Compressor
+    gain.reset(); //Gain
+    modulation.reset(); //Filter Modulation
+}
+
+//==============================================================================
+template <typename SampleType>
+void PluginEngine<SampleType>::update(const ParameterCache& parameterCache, ParameterCache::Mask changed) noexcept
+{
+    //Every setter recomputes coefficients, so only the setters of the parameters that moved are called
+    auto hasChanged = [changed](ParameterCache::Parameter parameter) { return (changed & ParameterCache::bit(parameter)) != 0; };
+
+    //Filter
+    if (hasChanged(ParameterCache::filterType))
+        filterSetType(parameterCache); //Sets the type
+    if (hasChanged(ParameterCache::filterFrequency))
+    {
+        baseFrequency = parameterCache.get(ParameterCache::filterFrequency); //Kept for the modulation
+        filter.setCutoffFrequency(filterLimitFrequency(baseFrequency)); //Sets the value of the frequency (tan())
+        ladderFilter.setCutoffFrequency(filterLimitFrequency(baseFrequency));
+    }
+    if (hasChanged(ParameterCache::filterResonance))
+    {
+        baseResonance = parameterCache.get(ParameterCache::filterResonance);
+        filter.setResonance(baseResonance); //Sets the value of the resonance
+        ladderFilter.setResonance(baseResonance);
+        modulatedResonance = 0; //The next chunk sets the modulated resonance again
+    }
+    if (hasChanged(ParameterCache::filterSlope))
+        filter.setNumSections(juce::jlimit(1, SIMDStateVariableFilter<SampleType>::maximumNumSections, parameterCache.getInt(ParameterCache::filterSlope) + 1)); //Sets the number of sections
+    if (hasChanged(ParameterCache::filterTopology))
+        filterSetTopology(parameterCache); //Selects the state variable or the ladder filter
+    if (hasChanged(ParameterCache::filterOversampling) || hasChanged(ParameterCache::filterOversamplingType))
+        filterSetOversampling(parameterCache); //Selects the oversampling
+    filterSetModulation(parameterCache, changed); //Sets the LFO and the follower (Only the changed parameters)
+    //Compressor (Everything but the threshold and the lookahead is shared with the multiband compressor)
+    if (hasChanged(ParameterCache::compressorAttack))
+    {
+        compressor.setAttack(parameterCache.get(ParameterCache::compressorAttack)); //Sets the value of the attack (exp())
+        multibandCompressor.setAttack(parameterCache.get(ParameterCache::compressorAttack));
+    }
+    if (hasChanged(ParameterCache::compressorRatio))
+    {
+        compressor.setRatio(parameterCache.get(ParameterCache::compressorRatio)); //Sets the value of the ratio
+        multibandCompressor.setRatio(parameterCache.get(ParameterCache::compressorRatio));
+    }
+    if (hasChanged(ParameterCache::compressorRelease))
+    {
+        compressor.setRelease(parameterCache.get(ParameterCache::compressorRelease)); //Sets the value of the release (exp())
+        multibandCompressor.setRelease(parameterCache.get(ParameterCache::compressorRelease));
+    }
+    if (hasChanged(ParameterCache::compressorThreshold))
+        compressor.setThreshold(parameterCache.get(ParameterCache::compressorThreshold)); //Sets the value of the threshold (Only stored in dB)
+    if (hasChanged(ParameterCache::compressorLink))
+    {
+        compressor.setLinked(parameterCache.getBool(ParameterCache::compressorLink)); //Links the channels
+        multibandCompressor.setLinked(parameterCache.getBool(ParameterCache::compressorLink));
+    }
+    if (hasChanged(ParameterCache::compressorLinkAmount))
+    {
+        compressor.setLinkAmount(parameterCache.get(ParameterCache::compressorLinkAmount) * SampleType(0.01)); //Sets how far the channels are linked (% to 0-1)
+        multibandCompressor.setLinkAmount(parameterCache.get(ParameterCache::compressorLinkAmount) * SampleType(0.01));
+    }
+    if (hasChanged(ParameterCache::compressorDetector))
+    {
+        compressor.setRmsDetector(parameterCache.getInt(ParameterCache::compressorDetector) == CompressorDetectors::rms); //Selects the peak or the RMS detector
+        multibandCompressor.setRmsDetector(parameterCache.getInt(ParameterCache::compressorDetector) == CompressorDetectors::rms);
+    }
+    if (hasChanged(ParameterCache::compressorRmsWindow))
+    {
+        compressor.setRmsWindow(parameterCache.get(ParameterCache::compressorRmsWindow)); //Sets the RMS window (Only adds up the squares of the preallocated window again)
+        multibandCompressor.setRmsWindow(parameterCache.get(ParameterCache::compressorRmsWindow));
+    }
+    if (hasChanged(ParameterCache::compressorKnee))
+    {
+        compressor.setKnee(parameterCache.get(ParameterCache::compressorKnee)); //Sets the width of the knee
+        multibandCompressor.setKnee(parameterCache.get(ParameterCache::compressorKnee));
+    }
+    if (hasChanged(ParameterCache::compressorLookahead))
+        compressor.setLookahead(parameterCache.get(ParameterCache::compressorLookahead)); //Sets the lookahead (Only moves a position in the preallocated delay buffer)
+    if (hasChanged(ParameterCache::compressorSidechainHighpass) || hasChanged(ParameterCache::compressorSidechainFrequency))
+        compressor.setKeyHighpass(parameterCache.getBool(ParameterCache::compressorSidechainHighpass) ? parameterCache.get(ParameterCache::compressorSidechainFrequency) : SampleType(0)); //Sets the highpass of the key (tan())
+    //Multiband Compressor
+    if (hasChanged(ParameterCache::compressorBands))
+        multibandCompressor.setNumBands(parameterCache.getInt(ParameterCache::compressorBands) == CompressorBands::four ? 4 : 3); //Sets the number of bands
+    if (hasChanged(ParameterCache::compressorCrossoverLow))
+        multibandCompressor.setCrossoverFrequency(0, parameterCache.get(ParameterCache::compressorCrossoverLow)); //Sets the crossovers (tan())
+    if (hasChanged(ParameterCache::compressorCrossoverMid))
+        multibandCompressor.setCrossoverFrequency(1, parameterCache.get(ParameterCache::compressorCrossoverMid));
+    if (hasChanged(ParameterCache::compressorCrossoverHigh))
+        multibandCompressor.setCrossoverFrequency(2, parameterCache.get(ParameterCache::compressorCrossoverHigh));
+    for (int band = 0; band < MultibandCompressor<SampleType>::maximumNumBands; ++band)
+    {
+        const auto parameter = (ParameterCache::Parameter) (ParameterCache::compressorBand1Threshold + band);
+        if (hasChanged(parameter))
+            multibandCompressor.setThreshold(band, parameterCache.get(parameter)); //Sets the threshold of every band (Only stored in dB)
+    }
+    //Gain
+    if (hasChanged(ParameterCache::gainGain))
+        gain.setGainLinear(FastMath::decibelsToGain(static_cast<SampleType>(parameterCache.get(ParameterCache::gainGain)))); //Sets the value of the gain (Same as setGainDecibels() without pow())
+    //Chain
+    if (hasChanged(ParameterCache::chainOrder) || hasChanged(ParameterCache::chainFilter) || hasChanged(ParameterCache::chainCompressor) || hasChanged(ParameterCache::chainGain))
+        chainSetStages(parameterCache); //Sets the order and the enabled stages
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::setTempo(double bpm, double ppqPosition, bool isPlaying) noexcept
+{
+    modulation.setTempo(bpm, ppqPosition, isPlaying);
+}
+
+template <typename SampleType>
+int PluginEngine<SampleType>::getLatencyInSamples(const ParameterCache& parameterCache) const noexcept
+{
+    //The oversampling of the filter and the lookahead of the compressor only add latency when their stage runs
+    const auto pluginType = parameterCache.getInt(ParameterCache::pluginType);
+    const auto usesFilter = pluginType == PluginTypes::chain ? parameterCache.getBool(ParameterCache::chainFilter) : pluginType == PluginTypes::filter;
+    const auto usesCompressor = pluginType == PluginTypes::chain ? parameterCache.getBool(ParameterCache::chainCompressor) : pluginType == PluginTypes::compressor;
+
+    auto latency = 0;
+
+    if (usesFilter && oversampler != nullptr)
+        latency += (int) oversampler->getLatencyInSamples();
+
+    if (usesCompressor && ! parameterCache.getBool(ParameterCache::compressorMultiband)) //The multiband compressor has no lookahead
+        latency += compressor.getLatencyInSamples();
+
+    return latency;
+}
+
+template <typename SampleType>
+double PluginEngine<SampleType>::getTailLengthSeconds(const ParameterCache& parameterCache) const noexcept
+{
+    //Number of time constants an exponential decay needs to fall by tailThresholddB (ln(10^(dB/20)))
+    const auto numTimeConstants = -tailThresholddB / 20.0 * std::log(10.0);
+
+    const auto pluginType = parameterCache.getInt(ParameterCache::pluginType);
+    const auto usesFilter = pluginType == PluginTypes::chain ? parameterCache.getBool(ParameterCache::chainFilter) : pluginType == PluginTypes::filter;
+    const auto usesCompressor = pluginType == PluginTypes::chain ? parameterCache.getBool(ParameterCache::chainCompressor) : pluginType == PluginTypes::compressor;
+
+    auto tail = (double) getLatencyInSamples(parameterCache) / sampleRate; //The delay of the oversampling and of the lookahead is part of the tail
+
+    if (usesFilter) //The lower and the more resonant the filter, the longer it rings
+    {
+        //The LFO moves both ways and the follower only towards its depths, so the lowest cutoff and the highest resonance they reach ring the longest
+        const auto lowestOctaves = std::abs(parameterCache.get(ParameterCache::filterLfoCutoff)) + juce::jmax(0.0f, -parameterCache.get(ParameterCache::filterEnvelopeCutoff));
+        const auto highestResonance = std::abs(parameterCache.get(ParameterCache::filterLfoResonance)) + juce::jmax(0.0f, parameterCache.get(ParameterCache::filterEnvelopeResonance));
+        const auto frequency = juce::jmax(20.0, parameterCache.get(ParameterCache::filterFrequency) * std::exp2(-(double) lowestOctaves));
+        const auto resonance = juce::jmin(10.0, (double) (parameterCache.get(ParameterCache::filterResonance) + highestResonance));
+
+        if (parameterCache.getInt(ParameterCache::filterTopology) == FilterTopologies::ladder) //The resonant poles are at (-1 + k^(1/4) (1 +- j) / sqrt(2)) times the cutoff
+        {
+            const auto damping = 1.0 - std::pow(SIMDLadderFilter<SampleType>::getFeedback(resonance), 0.25) / juce::MathConstants<double>::sqrt2;
+            tail += numTimeConstants / (juce::MathConstants<double>::twoPi * frequency * damping);
+        }
+        else //Every section rings after the one before it
+        {
+            const auto numSections = juce::jlimit(1, SIMDStateVariableFilter<SampleType>::maximumNumSections, parameterCache.getInt(ParameterCache::filterSlope) + 1);
+
+            for (int section = 0; section < numSections; ++section)
+                tail += numTimeConstants * SIMDStateVariableFilter<SampleType>::getSectionResonance(section, numSections, resonance, filterGetType(parameterCache))
+                      / (juce::MathConstants<double>::pi * frequency);
+        }
+    }
+
+    if (usesCompressor)
+    {
+        //The envelope falls back with the release, after that the compressor starts from the same state as after a reset
+        tail += numTimeConstants * parameterCache.get(ParameterCache::compressorRelease) / (1000.0 * juce::MathConstants<double>::twoPi);
+
+        if (parameterCache.getInt(ParameterCache::compressorDetector) == CompressorDetectors::rms) //The last loud samples stay in the RMS window for its whole length
+            tail += parameterCache.get(ParameterCache::compressorRmsWindow) * 0.001;
+
+        if (parameterCache.getBool(ParameterCache::compressorMultiband)) //The lowest crossover rings the longest (Two Butterworth filters in a row, Q = 1 / sqrt(2))
+            tail += 2.0 * numTimeConstants * (1.0 / juce::MathConstants<double>::sqrt2) / (juce::MathConstants<double>::pi * parameterCache.get(ParameterCache::compressorCrossoverLow));
+    }
+
+    return tail;
+}
+
+template <typename SampleType>
+SampleType PluginEngine<SampleType>::getCompressorGain(const ParameterCache& parameterCache) const noexcept
+{
+    const auto pluginType = parameterCache.getInt(ParameterCache::pluginType);
+    const auto usesCompressor = pluginType == PluginTypes::chain ? parameterCache.getBool(ParameterCache::chainCompressor) : pluginType == PluginTypes::compressor;
+
+    if (! usesCompressor)
+        return SampleType(1);
+
+    return parameterCache.getBool(ParameterCache::compressorMultiband) ? multibandCompressor.getGain() : compressor.getGain();
+}
+
+//==============================================================================
+template <typename SampleType>
+void PluginEngine<SampleType>::process(const ParameterCache& parameterCache, juce::dsp::AudioBlock<SampleType>& block,
+                                       const juce::dsp::AudioBlock<const SampleType>& sidechainBlock) noexcept
+{
+    auto context = juce::dsp::ProcessContextReplacing<SampleType>(block); //Processes the audioblock and replaces it (https://docs.juce.com/master/structdsp_1_1ProcessContextReplacing.html)
+
+    switch (parameterCache.getInt(ParameterCache::pluginType))
+    {
+    case PluginTypes::compressor: //Compressor
+        compressorProcess(parameterCache, context, sidechainBlock); //Initialazes the process of the compressor
+        gain.process(context); //Initialazes the process of the gain
+        break;
+    case PluginTypes::chain: //Chain (Every enabled stage in order, in place on the same block so nothing is copied between them)
+        for (int i = 0; i < numChainStages; ++i)
+        {
+            switch (chainStages[(size_t) i])
+            {
+            case ChainStage::filter:     filterProcess(block); break;
+            case ChainStage::compressor: compressorProcess(parameterCache, context, sidechainBlock); break;
+            case ChainStage::gain:       gain.process(context); break;
+            }
+        }
+        break;
+    default: //Filter (Also the default state like before)
+        filterProcess(block);
+        break;
+    }
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::compressorProcess(const ParameterCache& parameterCache, const juce::dsp::ProcessContextReplacing<SampleType>& context,
+                                                 const juce::dsp::AudioBlock<const SampleType>& sidechainBlock) noexcept //Runs the multiband compressor when it is on, the broadband one otherwise
+{
+    const auto isKeyed = sidechainBlock.getNumChannels() > 0 && parameterCache.getBool(ParameterCache::compressorSidechain); //Keyed by itself when the host does not feed the sidechain
+
+    if (parameterCache.getBool(ParameterCache::compressorMultiband))
+    {
+        if (isKeyed)
+            multibandCompressor.process(context, sidechainBlock);
+        else
+            multibandCompressor.process(context);
+    }
+    else if (isKeyed)
+    {
+        compressor.process(context, sidechainBlock);
+    }
+    else
+    {
+        compressor.process(context);
+    }
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::filterProcess(juce::dsp::AudioBlock<SampleType>& block) noexcept //Runs the filter, in steps of the control rate when it is modulated
+{
+    if (! isModulated)
+    {
+        filterProcessChunk(block);
+        return;
+    }
+
+    //The LFO and the follower move once per chunk and the filter ramps its coefficients over it, so tan() only runs once per chunk
+    const auto numSamples = block.getNumSamples();
+
+    for (size_t start = 0; start < numSamples; start += controlRate)
+    {
+        auto chunk = block.getSubBlock(start, juce::jmin(controlRate, numSamples - start));
+        filterModulate(modulation.advance(chunk)); //The follower reads the input of the filter
+        filterProcessChunk(chunk);
+    }
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::filterModulate(const typename FilterModulation<SampleType>::Values& values) noexcept //Sets the filter in use to the modulated values (The other one is set when it is selected)
+{
+    const auto frequency = filterLimitFrequency(baseFrequency * std::exp2(values.cutoffOctaves));
+    const auto resonance = juce::jlimit(SampleType(1), SampleType(10), baseResonance + values.resonance);
+
+    if (useLadder)
+        ladderFilter.setCutoffFrequency(frequency);
+    else
+        filter.setCutoffFrequency(frequency);
+
+    if (resonance != modulatedResonance) //The Q of the sections of the state variable filter needs cos(), so it is only recomputed when it moved
+    {
+        modulatedResonance = resonance;
+        filter.setResonance(resonance);
+        ladderFilter.setResonance(resonance);
+    }
+}
+
+template <typename SampleType>
+SampleType PluginEngine<SampleType>::filterLimitFrequency(SampleType frequency) const noexcept //Same range as the frequency parameter, below the Nyquist frequency of the host (A 20 kHz cutoff is above it at 32 kHz)
+{
+    const auto maximumFrequency = static_cast<SampleType>(juce::jmin(20000.0, sampleRate * 0.49));
+    return juce::jlimit(SampleType(20), maximumFrequency, frequency);
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::filterProcessChunk(juce::dsp::AudioBlock<SampleType>& block) noexcept //Runs the filter, at the oversampled rate when the oversampling is on
+{
+    if (oversampler != nullptr) //The filter runs at the oversampled rate between the up and the down sampling
+    {
+        auto oversampledBlock = oversampler->processSamplesUp(block);
+
+        if (useLadder)
+            ladderFilter.process(juce::dsp::ProcessContextReplacing<SampleType>(oversampledBlock));
+        else
+            filter.process(juce::dsp::ProcessContextReplacing<SampleType>(oversampledBlock));
+
+        oversampler->processSamplesDown(block);
+    }
+    else if (useLadder)
+    {
+        ladderFilter.process(juce::dsp::ProcessContextReplacing<SampleType>(block)); //Initialazes the process of the ladder filter
+    }
+    else
+    {
+        filter.process(juce::dsp::ProcessContextReplacing<SampleType>(block)); //Initialazes the process of the filter
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+juce::dsp::StateVariableTPTFilterType PluginEngine<SampleType>::filterGetType(const ParameterCache& parameterCache) noexcept //Switch case for selecting the filter type
+{
+    switch (parameterCache.getInt(ParameterCache::filterType)) //Switch was used instead of if as it looks nicer and it was autocompleted which helped eliminating misstyping in the process
+    {
+    case FilterTypes::lowPass: //Low Pass
+        return juce::dsp::StateVariableTPTFilterType::lowpass;
+    case FilterTypes::bandPass: //Band Pass
+        return juce::dsp::StateVariableTPTFilterType::bandpass;
+    case FilterTypes::highPass: //High Pass
+        return juce::dsp::StateVariableTPTFilterType::highpass;
+    default: //Low Pass
+        return juce::dsp::StateVariableTPTFilterType::lowpass;
+    }
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::filterSetType(const ParameterCache& parameterCache) noexcept
+{
+    const auto type = filterGetType(parameterCache);
+    filter.setType(type); //The function sets the type of the filter
+    ladderFilter.setType(type);
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::filterSetTopology(const ParameterCache& parameterCache) noexcept //Both filters follow the parameters, only the selected one runs
+{
+    const auto newUseLadder = parameterCache.getInt(ParameterCache::filterTopology) == FilterTopologies::ladder;
+
+    if (newUseLadder != useLadder)
+    {
+        useLadder = newUseLadder;
+
+        if (useLadder) //Clears what was left from the last time it was used
+            ladderFilter.reset();
+        else
+            filter.reset();
+    }
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::filterSetOversampling(const ParameterCache& parameterCache) noexcept //Selects the oversampling of the filter
+{
+    const auto order = juce::jlimit(0, maximumOversamplingOrder, parameterCache.getInt(ParameterCache::filterOversampling));
+    const auto type = juce::jlimit(0, 1, parameterCache.getInt(ParameterCache::filterOversamplingType));
+    auto* newOversampler = order > 0 ? oversamplers[(size_t) ((order - 1) * 2 + type)].get() : nullptr;
+
+    if (newOversampler != oversampler)
+    {
+        oversampler = newOversampler;
+
+        if (oversampler != nullptr)
+            oversampler->reset(); //Clears what was left from the last time it was used
+
+        filter.setSampleRate(sampleRate * (1 << order)); //The filter runs at the oversampled rate, so its coefficients change
+        filter.reset();
+        ladderFilter.setSampleRate(sampleRate * (1 << order));
+        ladderFilter.reset();
+    }
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::filterSetModulation(const ParameterCache& parameterCache, ParameterCache::Mask changed) noexcept //Sends the modulation parameters that moved to the LFO and the follower
+{
+    auto hasChanged = [changed](ParameterCache::Parameter parameter) { return (changed & ParameterCache::bit(parameter)) != 0; };
+    static constexpr double divisionBeats[] = { 16.0, 8.0, 4.0, 2.0, 1.0, 0.5, 0.25, 2.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 }; //Length of every choice of the filterLfoDivision parameter in quarter notes
+
+    if (hasChanged(ParameterCache::filterLfoShape))
+        modulation.setLfoShape(parameterCache.getInt(ParameterCache::filterLfoShape));
+    if (hasChanged(ParameterCache::filterLfoRate))
+        modulation.setLfoRate(parameterCache.get(ParameterCache::filterLfoRate));
+    if (hasChanged(ParameterCache::filterLfoSync))
+        modulation.setLfoSync(parameterCache.getBool(ParameterCache::filterLfoSync));
+    if (hasChanged(ParameterCache::filterLfoDivision))
+        modulation.setLfoBeats(divisionBeats[juce::jlimit(0, (int) std::size(divisionBeats) - 1, parameterCache.getInt(ParameterCache::filterLfoDivision))]);
+    if (hasChanged(ParameterCache::filterLfoCutoff) || hasChanged(ParameterCache::filterLfoResonance))
+        modulation.setLfoDepths(parameterCache.get(ParameterCache::filterLfoCutoff), parameterCache.get(ParameterCache::filterLfoResonance));
+    if (hasChanged(ParameterCache::filterEnvelopeAttack))
+        modulation.setEnvelopeAttack(parameterCache.get(ParameterCache::filterEnvelopeAttack));
+    if (hasChanged(ParameterCache::filterEnvelopeRelease))
+        modulation.setEnvelopeRelease(parameterCache.get(ParameterCache::filterEnvelopeRelease));
+    if (hasChanged(ParameterCache::filterEnvelopeCutoff) || hasChanged(ParameterCache::filterEnvelopeResonance))
+        modulation.setEnvelopeDepths(parameterCache.get(ParameterCache::filterEnvelopeCutoff), parameterCache.get(ParameterCache::filterEnvelopeResonance));
+    if (hasChanged(ParameterCache::filterControlRate))
+        controlRate = (size_t) 8 << juce::jlimit(0, (int) ControlRates::samples64, parameterCache.getInt(ParameterCache::filterControlRate));
+
+    if (modulation.isActive() != isModulated)
+    {
+        isModulated = modulation.isActive();
+        filter.setCoefficientRamping(isModulated);
+        ladderFilter.setCoefficientRamping(isModulated);
+        modulatedResonance = 0;
+
+        if (! isModulated) //Back to the values of the parameters
+        {
+            filter.setCutoffFrequency(filterLimitFrequency(baseFrequency));
+            filter.setResonance(baseResonance);
+            ladderFilter.setCutoffFrequency(filterLimitFrequency(baseFrequency));
+            ladderFilter.setResonance(baseResonance);
+        }
+    }
+}
+
+template <typename SampleType>
+void PluginEngine<SampleType>::chainSetStages(const ParameterCache& parameterCache) noexcept //Builds the list of the enabled stages of the chain in the chosen order
+{
+    using Stage = ChainStage;
+    static constexpr Stage orders[][3] = //Same order as the choices of the chainOrder parameter
+    {
+        { Stage::filter, Stage::compressor, Stage::gain },
+        { Stage::filter, Stage::gain, Stage::compressor },
+        { Stage::compressor, Stage::filter, Stage::gain },
+        { Stage::compressor, Stage::gain, Stage::filter },
+        { Stage::gain, Stage::filter, Stage::compressor },
+        { Stage::gain, Stage::compressor, Stage::filter }
+    };
+
+    const auto order = juce::jlimit(0, (int) std::size(orders) - 1, parameterCache.getInt(ParameterCache::chainOrder));
+    numChainStages = 0;
+
+    for (auto stage : orders[order])
+    {
+        const auto isEnabled = stage == Stage::filter ? parameterCache.getBool(ParameterCache::chainFilter)
+                             : stage == Stage::compressor ? parameterCache.getBool(ParameterCache::chainCompressor)
+                                                          : parameterCache.getBool(ParameterCache::chainGain);
+
+        if (isEnabled)
+            chainStages[(size_t) numChainStages++] = stage;
+    }
+}
+
+//==============================================================================
+template class PluginEngine<float>;
+template class PluginEngine<double>;
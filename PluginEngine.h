@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    This file contains the DSP engine of the plugin.
+
+    Every DSP process of the plugin (Filter with its oversampling, compressor, multiband compressor, gain and the
+    order of the chain) lives here, templated on the sample type. The processor owns one engine for float and one
+    for double and only prepares the one that matches the precision the host asked for, so a 64 bit host runs the
+    whole chain in double without converting the buffers. The engine reads the parameters from the ParameterCache of
+    the processor and does not know about the host.
+
+    The filter can be modulated by an LFO and an envelope follower. The block is then cut into chunks of the control
+    rate and the filter is set to the modulated cutoff and resonance before every chunk, with its coefficients ramped
+    over the chunk. The tempo of the host reaches the LFO through setTempo(), called by the processor.
+
+    The tail is computed from the decay of the resonant filters (A state variable filter decays with a time constant
+    of Q / (pi * cutoff) for every section, the ladder with the distance of its resonant poles to the imaginary axis)
+    and from the release of the compressors, so the processor can stop processing silent input once everything has
+    died out. With the modulation, the tail is the one of the lowest and most resonant setting the depths can reach.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginParameters.h"
+#include "ParameterCache.h"
+#include "SIMDStateVariableFilter.h"
+#include "SIMDLadderFilter.h"
+#include "MultiChannelCompressor.h"
+#include "MultibandCompressor.h"
+#include "FilterModulation.h"
+
+//==============================================================================
+template <typename SampleType>
+class PluginEngine
+{
+public:
+    static constexpr int maximumOversamplingOrder = OversamplingFactors::x8; //8x (The factor is 2 to the power of the order)
+    static constexpr double tailThresholddB = -100.0; //The tail ends when the output has decayed by this much
+
+    //==============================================================================
+    void prepare(const juce::dsp::ProcessSpec& spec); //Allocates every DSP process and every oversampling
+    void release(); //Frees the oversampling (Used when the host switches to the other precision)
+    void reset() noexcept; //Clears the state of every DSP process
+
+    void update(const ParameterCache& parameterCache, ParameterCache::Mask changed) noexcept; //Sends the values of the changed parameters to the DSP processes
+    void setTempo(double bpm, double ppqPosition, bool isPlaying) noexcept; //Tempo and position of the host at the start of the block (Used by the synced LFO)
+    int getLatencyInSamples(const ParameterCache& parameterCache) const noexcept; //Latency of the oversampling and of the lookahead of the stages in use
+    double getTailLengthSeconds(const ParameterCache& parameterCache) const noexcept; //Time the stages in use keep ringing after the input stopped (Latency included)
+    SampleType getCompressorGain(const ParameterCache& parameterCache) const noexcept; //Gain applied by the compressor in use at the end of the last block (1 without compressor)
+
+    //==============================================================================
+    void process(const ParameterCache& parameterCache, juce::dsp::AudioBlock<SampleType>& block,
+                 const juce::dsp::AudioBlock<const SampleType>& sidechainBlock = {}) noexcept; //Runs the selected mode in place on the block (The sidechain is empty when the host does not feed it)
+
+private:
+    static juce::dsp::StateVariableTPTFilterType filterGetType(const ParameterCache& parameterCache) noexcept; //Function that converts the filter type parameter to the type of the filters
+    void filterSetType(const ParameterCache& parameterCache) noexcept; //Function that sets the type of the filter
+    void filterSetTopology(const ParameterCache& parameterCache) noexcept; //Function that selects the state variable or the ladder filter
+    void filterSetOversampling(const ParameterCache& parameterCache) noexcept; //Function that selects the oversampling of the filter
+    void chainSetStages(const ParameterCache& parameterCache) noexcept; //Function that sets the order of the chain and leaves out the disabled stages
+    void filterSetModulation(const ParameterCache& parameterCache, ParameterCache::Mask changed) noexcept; //Function that sends the changed modulation parameters to the LFO and the follower
+    void filterModulate(const typename FilterModulation<SampleType>::Values& values) noexcept; //Function that sets the filter in use to the modulated cutoff and resonance
+    SampleType filterLimitFrequency(SampleType frequency) const noexcept; //Function that keeps a cutoff between 20 Hz and the lower of 20 kHz and the Nyquist frequency of the host
+    void filterProcess(juce::dsp::AudioBlock<SampleType>& block) noexcept; //Function that runs the filter on a block, in chunks of the control rate when it is modulated
+    void filterProcessChunk(juce::dsp::AudioBlock<SampleType>& block) noexcept; //Function that runs the filter with its oversampling on a block
+    void compressorProcess(const ParameterCache& parameterCache, const juce::dsp::ProcessContextReplacing<SampleType>& context,
+                           const juce::dsp::AudioBlock<const SampleType>& sidechainBlock) noexcept; //Function that runs the broadband or the multiband compressor, keyed by the sidechain when it is on
+
+    //==============================================================================
+    SIMDStateVariableFilter<SampleType> filter; //State Variable TPT Filter (Processes the channels in SIMD lanes, 1 to 4 sections)
+    SIMDLadderFilter<SampleType> ladderFilter; //Ladder Filter (Used instead of the state variable filter when the topology is Ladder)
+    bool useLadder = false;
+    FilterModulation<SampleType> modulation; //LFO and envelope follower of the cutoff and the resonance
+    bool isModulated = false; //Set while a depth is not 0 (The filters ramp their coefficients)
+    size_t controlRate = 32; //Samples between two steps of the modulation
+    SampleType baseFrequency = 400, baseResonance = 1, modulatedResonance = 0; //Values of the parameters and last resonance sent by the modulation
+    MultiChannelCompressor<SampleType> compressor; //Compressor (With optional linking of the channels)
+    MultibandCompressor<SampleType> multibandCompressor; //Multiband Compressor (Used instead of the compressor when the multiband parameter is on)
+    juce::dsp::Gain<SampleType> gain; //Gain
+
+    //Oversampling of the filter, one for every factor and type. They are all allocated in prepare(), so changing the
+    //factor or the type on the audio thread only swaps a pointer. Only the selected one runs, so the cost grows with the factor.
+    std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, maximumOversamplingOrder * 2> oversamplers;
+    juce::dsp::Oversampling<SampleType>* oversampler = nullptr; //Oversampling used around the filter (nullptr when it is off)
+
+    //Chain mode (Every enabled stage runs in place on the same block, the disabled ones are not in the list so they cost nothing)
+    enum class ChainStage { filter, compressor, gain };
+    std::array<ChainStage, 3> chainStages {}; //Enabled stages in the order they run
+    int numChainStages = 0;
+
+    double sampleRate = 44100.0; //Rate of the host (The filter runs at a multiple of it when it is oversampled)
+};
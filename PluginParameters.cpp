@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    This file contains the parameters of the plugin.
+
+    The ranges are the same as the ranges the sliders of the editor used before the parameters were added, so old
+    sessions and the editor behave the same.
+
+  ==============================================================================
+*/
+
+#include "PluginParameters.h"
+
+//==============================================================================
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    //Plugin Type
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::pluginType, 1 }, "Plugin Type",
+                                                            juce::StringArray { "Filter", "Compressor", "Chain" }, PluginTypes::filter));
+
+    //Filter
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterFrequency, 1 }, "Frequency",
+                                                           juce::NormalisableRange<float>(20.0f, 20000.0f, 1.0f, 0.3f), 400.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("Hz"))); //Same skew factor as the slider
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterResonance, 1 }, "Resonance",
+                                                           juce::NormalisableRange<float>(1.0f, 10.0f, 0.1f), 1.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterType, 1 }, "Filter Type",
+                                                            juce::StringArray { "Low Pass", "Band Pass", "High Pass" }, FilterTypes::lowPass));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterOversampling, 1 }, "Oversampling",
+                                                            juce::StringArray { "Off", "2x", "4x", "8x" }, OversamplingFactors::off)); //Off by default so old sessions have no latency
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterOversamplingType, 1 }, "Oversampling Type",
+                                                            juce::StringArray { "Low Latency (IIR)", "Linear Phase (FIR)" }, OversamplingTypes::lowLatency));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterSlope, 1 }, "Slope",
+                                                            juce::StringArray { "12 dB/oct", "24 dB/oct", "36 dB/oct", "48 dB/oct" }, FilterSlopes::dB12)); //12 dB/oct by default like before
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterTopology, 1 }, "Topology",
+                                                            juce::StringArray { "State Variable", "Ladder" }, FilterTopologies::stateVariable)); //The ladder is always 24 dB/oct
+
+    //Filter Modulation (Every depth is 0 by default, so the filter is not modulated like before)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterLfoShape, 1 }, "LFO Shape",
+                                                            juce::StringArray { "Sine", "Triangle", "Saw", "Square" }, LfoShapes::sine));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterLfoRate, 1 }, "LFO Rate",
+                                                           juce::NormalisableRange<float>(0.01f, 20.0f, 0.01f, 0.3f), 1.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("Hz")));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::filterLfoSync, 1 }, "LFO Sync", false)); //Follows the tempo of the host with the division
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterLfoDivision, 1 }, "LFO Division",
+                                                            juce::StringArray { "4 Bars", "2 Bars", "1 Bar", "1/2", "1/4", "1/8", "1/16", "1/4T", "1/8T", "1/16T" },
+                                                            LfoDivisions::quarter));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterLfoCutoff, 1 }, "LFO Frequency Depth",
+                                                           juce::NormalisableRange<float>(-4.0f, 4.0f, 0.01f), 0.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("oct")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterLfoResonance, 1 }, "LFO Resonance Depth",
+                                                           juce::NormalisableRange<float>(-5.0f, 5.0f, 0.1f), 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterEnvelopeAttack, 1 }, "Envelope Attack",
+                                                           juce::NormalisableRange<float>(0.1f, 100.0f, 0.1f, 0.5f), 5.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("ms")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterEnvelopeRelease, 1 }, "Envelope Release",
+                                                           juce::NormalisableRange<float>(5.0f, 2000.0f, 0.1f, 0.4f), 150.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("ms")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterEnvelopeCutoff, 1 }, "Envelope Frequency Depth",
+                                                           juce::NormalisableRange<float>(-4.0f, 4.0f, 0.01f), 0.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("oct"))); //Reached at 0 dB
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::filterEnvelopeResonance, 1 }, "Envelope Resonance Depth",
+                                                           juce::NormalisableRange<float>(-5.0f, 5.0f, 0.1f), 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::filterControlRate, 1 }, "Modulation Control Rate",
+                                                            juce::StringArray { "8 Samples", "16 Samples", "32 Samples", "64 Samples" },
+                                                            ControlRates::samples32)); //The coefficients are ramped between the steps
+
+    //Compressor
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorAttack, 1 }, "Attack",
+                                                           juce::NormalisableRange<float>(0.01f, 300.0f, 0.0001f), 0.01f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("ms")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorRatio, 1 }, "Ratio",
+                                                           juce::NormalisableRange<float>(1.0f, 10.0f, 1.0f), 1.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorRelease, 1 }, "Release",
+                                                           juce::NormalisableRange<float>(5.0f, 4000.0f, 0.1f), 5.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("ms")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorThreshold, 1 }, "Threshold",
+                                                           juce::NormalisableRange<float>(-30.0f, 0.0f, 1.0f), 0.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("dB")));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::compressorLink, 1 }, "Link Channels", false)); //Same gain on every channel
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorLookahead, 1 }, "Lookahead",
+                                                           juce::NormalisableRange<float>(0.0f, 10.0f, 0.1f), 0.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("ms"))); //Same maximum as MultiChannelCompressor::maximumLookaheadMs
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::compressorDetector, 1 }, "Detector",
+                                                            juce::StringArray { "Peak", "RMS" }, CompressorDetectors::peak)); //Peak by default like before
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorRmsWindow, 1 }, "RMS Window",
+                                                           juce::NormalisableRange<float>(1.0f, 50.0f, 0.1f), 10.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("ms"))); //Same maximum as MultiChannelCompressor::maximumRmsWindowMs
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorLinkAmount, 1 }, "Link Amount",
+                                                           juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 100.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("%"))); //Used when the link is on, 100% is the same gain on every channel like before
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorKnee, 1 }, "Knee",
+                                                           juce::NormalisableRange<float>(0.0f, 24.0f, 0.1f), 0.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("dB"))); //Hard knee by default like before
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::compressorSidechain, 1 }, "Sidechain", false)); //Keyed by the sidechain bus when the host feeds it
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::compressorSidechainHighpass, 1 }, "Sidechain Highpass", false));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorSidechainFrequency, 1 }, "Sidechain Frequency",
+                                                           juce::NormalisableRange<float>(20.0f, 500.0f, 1.0f, 0.5f), 100.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("Hz"))); //Keeps the low end from pumping the compressor
+
+    //Multiband Compressor (Uses the attack, ratio, release, link, detector and knee of the compressor, with a threshold for every band)
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::compressorMultiband, 1 }, "Multiband", false));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::compressorBands, 1 }, "Bands",
+                                                            juce::StringArray { "3 Bands", "4 Bands" }, CompressorBands::three));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorCrossoverLow, 1 }, "Low Crossover",
+                                                           juce::NormalisableRange<float>(40.0f, 500.0f, 1.0f, 0.5f), 200.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("Hz"))); //The ranges do not overlap so the bands stay in order
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorCrossoverMid, 1 }, "Mid Crossover",
+                                                           juce::NormalisableRange<float>(500.0f, 4000.0f, 1.0f, 0.5f), 1500.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("Hz")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::compressorCrossoverHigh, 1 }, "High Crossover",
+                                                           juce::NormalisableRange<float>(4000.0f, 16000.0f, 1.0f, 0.5f), 6000.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("Hz"))); //Only used with 4 bands
+    const char* bandThresholdIDs[] = { ParameterIDs::compressorBand1Threshold, ParameterIDs::compressorBand2Threshold,
+                                       ParameterIDs::compressorBand3Threshold, ParameterIDs::compressorBand4Threshold };
+    for (int band = 0; band < 4; ++band)
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { bandThresholdIDs[band], 1 }, "Band " + juce::String(band + 1) + " Threshold",
+                                                               juce::NormalisableRange<float>(-30.0f, 0.0f, 1.0f), 0.0f,
+                                                               juce::AudioParameterFloatAttributes().withLabel("dB"))); //Same range as the threshold
+
+    //Gain
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::gainGain, 1 }, "Gain",
+                                                           juce::NormalisableRange<float>(0.0f, 20.0f, 1.1f), 0.0f,
+                                                           juce::AudioParameterFloatAttributes().withLabel("dB")));
+
+    //Chain (Filter, compressor and gain in one instance, in the chosen order)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::chainOrder, 1 }, "Chain Order",
+                                                            juce::StringArray { "Filter > Compressor > Gain", "Filter > Gain > Compressor",
+                                                                                "Compressor > Filter > Gain", "Compressor > Gain > Filter",
+                                                                                "Gain > Filter > Compressor", "Gain > Compressor > Filter" },
+                                                            ChainOrders::filterCompressorGain));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::chainFilter, 1 }, "Chain Filter", true));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::chainCompressor, 1 }, "Chain Compressor", true));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { ParameterIDs::chainGain, 1 }, "Chain Gain", true));
+
+    return layout;
+}
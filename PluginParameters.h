@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    This file contains the parameters of the plugin.
+
+    Every value that the editor or the host can change is declared here once and is then shared by the processor,
+    the editor and the saved state through the AudioProcessorValueTreeState.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+namespace ParameterIDs //IDs used to find the parameters inside the AudioProcessorValueTreeState
+{
+    //Plugin Type
+    inline constexpr auto pluginType = "pluginType";
+    //Filter
+    inline constexpr auto filterFrequency = "filterFrequency"; //Frequency
+    inline constexpr auto filterResonance = "filterResonance"; //Resonance
+    inline constexpr auto filterType = "filterType"; //Type
+    inline constexpr auto filterOversampling = "filterOversampling"; //Oversampling Factor
+    inline constexpr auto filterOversamplingType = "filterOversamplingType"; //Oversampling Type
+    inline constexpr auto filterSlope = "filterSlope"; //Slope (Sections of the state variable filter)
+    inline constexpr auto filterTopology = "filterTopology"; //State Variable or Ladder
+    //Filter Modulation
+    inline constexpr auto filterLfoShape = "filterLfoShape"; //LFO Shape
+    inline constexpr auto filterLfoRate = "filterLfoRate"; //LFO Rate in Hz
+    inline constexpr auto filterLfoSync = "filterLfoSync"; //LFO Tempo Sync On/Off
+    inline constexpr auto filterLfoDivision = "filterLfoDivision"; //LFO Length when synced
+    inline constexpr auto filterLfoCutoff = "filterLfoCutoff"; //LFO Depth on the frequency
+    inline constexpr auto filterLfoResonance = "filterLfoResonance"; //LFO Depth on the resonance
+    inline constexpr auto filterEnvelopeAttack = "filterEnvelopeAttack"; //Envelope Follower Attack
+    inline constexpr auto filterEnvelopeRelease = "filterEnvelopeRelease"; //Envelope Follower Release
+    inline constexpr auto filterEnvelopeCutoff = "filterEnvelopeCutoff"; //Envelope Follower Depth on the frequency
+    inline constexpr auto filterEnvelopeResonance = "filterEnvelopeResonance"; //Envelope Follower Depth on the resonance
+    inline constexpr auto filterControlRate = "filterControlRate"; //Samples between two steps of the modulation
+    //Compressor
+    inline constexpr auto compressorAttack = "compressorAttack"; //Attack
+    inline constexpr auto compressorRatio = "compressorRatio"; //Ratio
+    inline constexpr auto compressorRelease = "compressorRelease"; //Release
+    inline constexpr auto compressorThreshold = "compressorThreshold"; //Threshold
+    inline constexpr auto compressorLink = "compressorLink"; //Link Channels
+    inline constexpr auto compressorLookahead = "compressorLookahead"; //Lookahead
+    inline constexpr auto compressorDetector = "compressorDetector"; //Peak or RMS Detector
+    inline constexpr auto compressorRmsWindow = "compressorRmsWindow"; //RMS Window
+    inline constexpr auto compressorLinkAmount = "compressorLinkAmount"; //Link Amount
+    inline constexpr auto compressorKnee = "compressorKnee"; //Knee Width
+    inline constexpr auto compressorSidechain = "compressorSidechain"; //External Sidechain On/Off
+    inline constexpr auto compressorSidechainHighpass = "compressorSidechainHighpass"; //Highpass of the key On/Off
+    inline constexpr auto compressorSidechainFrequency = "compressorSidechainFrequency"; //Frequency of the highpass of the key
+    inline constexpr auto compressorMultiband = "compressorMultiband"; //Multiband On/Off
+    inline constexpr auto compressorBands = "compressorBands"; //Number of Bands
+    inline constexpr auto compressorCrossoverLow = "compressorCrossoverLow"; //Crossover between the bands 1 and 2
+    inline constexpr auto compressorCrossoverMid = "compressorCrossoverMid"; //Crossover between the bands 2 and 3
+    inline constexpr auto compressorCrossoverHigh = "compressorCrossoverHigh"; //Crossover between the bands 3 and 4
+    inline constexpr auto compressorBand1Threshold = "compressorBand1Threshold"; //Threshold of every band
+    inline constexpr auto compressorBand2Threshold = "compressorBand2Threshold";
+    inline constexpr auto compressorBand3Threshold = "compressorBand3Threshold";
+    inline constexpr auto compressorBand4Threshold = "compressorBand4Threshold";
+    //Gain
+    inline constexpr auto gainGain = "gainGain";
+    //Chain
+    inline constexpr auto chainOrder = "chainOrder"; //Order of the stages
+    inline constexpr auto chainFilter = "chainFilter"; //Filter Stage On/Off
+    inline constexpr auto chainCompressor = "chainCompressor"; //Compressor Stage On/Off
+    inline constexpr auto chainGain = "chainGain"; //Gain Stage On/Off
+}
+
+//==============================================================================
+namespace PluginTypes //Choice indexes of the pluginType parameter
+{
+    enum { filter = 0, compressor, chain };
+}
+
+namespace FilterTypes //Choice indexes of the filterType parameter
+{
+    enum { lowPass = 0, bandPass, highPass };
+}
+
+namespace FilterSlopes //Choice indexes of the filterSlope parameter (The index plus one is the number of sections)
+{
+    enum { dB12 = 0, dB24, dB36, dB48 };
+}
+
+namespace FilterTopologies //Choice indexes of the filterTopology parameter
+{
+    enum { stateVariable = 0, ladder };
+}
+
+namespace LfoShapes //Choice indexes of the filterLfoShape parameter
+{
+    enum { sine = 0, triangle, saw, square };
+}
+
+namespace LfoDivisions //Choice indexes of the filterLfoDivision parameter (Length of a cycle of the synced LFO)
+{
+    enum { bars4 = 0, bars2, bar1, half, quarter, eighth, sixteenth, quarterTriplet, eighthTriplet, sixteenthTriplet };
+}
+
+namespace ControlRates //Choice indexes of the filterControlRate parameter (8 samples shifted left by the index)
+{
+    enum { samples8 = 0, samples16, samples32, samples64 };
+}
+
+namespace OversamplingFactors //Choice indexes of the filterOversampling parameter (The index is the power of two of the factor)
+{
+    enum { off = 0, x2, x4, x8 };
+}
+
+namespace OversamplingTypes //Choice indexes of the filterOversamplingType parameter
+{
+    enum { lowLatency = 0, linearPhase };
+}
+
+namespace CompressorDetectors //Choice indexes of the compressorDetector parameter
+{
+    enum { peak = 0, rms };
+}
+
+namespace CompressorBands //Choice indexes of the compressorBands parameter
+{
+    enum { three = 0, four };
+}
+
+namespace ChainOrders //Choice indexes of the chainOrder parameter
+{
+    enum { filterCompressorGain = 0, filterGainCompressor, compressorFilterGain, compressorGainFilter, gainFilterCompressor, gainCompressorFilter };
+}
+
+//==============================================================================
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout(); //Creates every parameter of the plugin
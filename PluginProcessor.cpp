@@ -11,6 +11,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "RealtimeCheck.h"
 
 //==============================================================================
 MultiPluginAudioProcessor::MultiPluginAudioProcessor()
@@ -19,16 +20,37 @@ MultiPluginAudioProcessor::MultiPluginAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false) //Key of the compressor
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
-                       )
+                       ),
+#else
+     :
 #endif
+       parameters (*this, nullptr, "Parameters", createParameterLayout()) //Creates the parameters declared in PluginParameters
 {
+    parameterCache.attach(parameters); //Getting the atomic values of the parameters that the audio thread reads
+
+    //Listening to every parameter so the audio thread knows when a value moved
+    for (auto* parameter : getParameters())
+        if (auto* rangedParameter = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            parameters.addParameterListener(rangedParameter->getParameterID(), this);
+
+   #if MULTIPLUGIN_PROFILING
+    profilingLogEnabled = juce::SystemStats::getEnvironmentVariable("MULTIPLUGIN_PROFILING_LOG", {}).isNotEmpty();
+   #endif
+
+    startTimerHz(30); //Program and latency changes reach the host within a frame
 }
 
 MultiPluginAudioProcessor::~MultiPluginAudioProcessor()
 {
+    stopTimer();
+
+    for (auto* parameter : getParameters())
+        if (auto* rangedParameter = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            parameters.removeParameterListener(rangedParameter->getParameterID(), this);
 }
 
 //==============================================================================
@@ -66,32 +88,79 @@ bool MultiPluginAudioProcessor::isMidiEffect() const
 
 double MultiPluginAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return tailLengthSeconds.load(); //Computed by the audio thread from the filter resonance and the compressor release
 }
 
 int MultiPluginAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return presetBank.getNumPresets(); //Factory presets and user presets (Always at least the Init preset)
 }
 
 int MultiPluginAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram.load();
 }
 
-void MultiPluginAudioProcessor::setCurrentProgram (int index)
+void MultiPluginAudioProcessor::setCurrentProgram (int index) //Can be called from the audio thread (MIDI program changes), so it only hands the index over
 {
+   #if MULTIPLUGIN_RT_CHECK
+    const RealtimeCheck::ScopedRealtimeThread realtimeCheck;
+   #endif
+
+    if (! juce::isPositiveAndBelow(index, presetBank.getNumPresets()))
+        return;
 
+    currentProgram.store(index);
+    programSent.store(-1, std::memory_order_relaxed); //An older send of the same program does not count for this one
+    pendingProgram.store(index, std::memory_order_release);
+    programToSend.store(index, std::memory_order_release);
 }
 
 const juce::String MultiPluginAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return juce::isPositiveAndBelow(index, presetBank.getNumPresets()) ? presetBank.getName(index) : juce::String();
 }
 
 void MultiPluginAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    juce::ignoreUnused(index, newName); //The names of the presets are fixed (User presets are named after their file)
+}
+
+void MultiPluginAudioProcessor::timerCallback() //Sends the programs picked by the host to its parameters and the latency to the host
+{
+    //Programs (Always sent from here, so a program reaches the parameters even when the host has stopped calling processBlock)
+    const auto program = programToSend.exchange(-1, std::memory_order_acquire);
+
+    if (program >= 0)
+    {
+        presetBank.sendToParameters(program);
+        programSent.store(program, std::memory_order_release);
+
+        auto notTaken = program; //The parameters have it now, so a block that runs later must not hold the program over newer values
+        pendingProgram.compare_exchange_strong(notTaken, -1, std::memory_order_acq_rel);
+    }
+
+    //Latency (setLatencySamples() notifies the host, which can lock or allocate, so the audio thread leaves it to the timer)
+    const auto latency = latencySamples.load();
+
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+
+   #if MULTIPLUGIN_PROFILING
+    //Profiling log (Written here so the audio thread never touches the logger)
+    if (profilingLogEnabled && ++timerCallbacksSinceLog >= profilingLogInterval)
+    {
+        timerCallbacksSinceLog = 0;
+        const auto statistics = profiler.getStatistics();
+
+        if (statistics.numOverruns < overrunsLogged) //The counters were cleared
+            overrunsLogged = 0;
+
+        juce::Logger::writeToLog("Multi-Plugin callback: " + statistics.toString()
+                                 + " (" + juce::String((juce::int64) (statistics.numOverruns - overrunsLogged)) + " new overruns)");
+        overrunsLogged = statistics.numOverruns;
+    }
+   #endif
 }
 
 //==============================================================================
@@ -101,16 +170,34 @@ void MultiPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     //Also used this tuti
     multiPluginSampleRate = sampleRate; //Samplerate sent to a variable in order to get saved to spec
 
+   #if MULTIPLUGIN_PROFILING
+    profiler.prepare(sampleRate); //New deadline, so the statistics start again
+   #endif
+
     juce::dsp::ProcessSpec spec; //Creates a struct were crucial information for dsp processing are saved
     spec.sampleRate = multiPluginSampleRate; //Sample Rate
     spec.maximumBlockSize = samplesPerBlock; //Bit Rate
-    spec.numChannels = getNumOutputChannels(); //Number of output channels
+    spec.numChannels = (juce::uint32) getMainBusNumOutputChannels(); //Number of output channels
+
+    //Preparing the engine of the precision used by the host (setProcessingPrecision() is only called before prepareToPlay)
+    if (isUsingDoublePrecision())
+    {
+        doubleEngine.prepare(spec);
+        floatEngine.release();
+    }
+    else
+    {
+        floatEngine.prepare(spec);
+        doubleEngine.release();
+    }
 
-    //Preparing the DSP processes
-    filter.prepare(spec); //Filter
-    compressor.prepare(spec); //Compressor
-    gain.prepare(spec); //Gain
-    reset(); //Calls the function reset created
+    silentSamples = 0; //The engine was just reset, so it starts like after a silent tail
+    isSuspended = false;
+
+    parameterCache.invalidate(); //Sends every parameter to the freshly prepared processes now, so the latency is reported before playback starts
+    parametersChanged = false;
+    updateProcessors(parameterCache.update());
+    setLatencySamples(latencySamples.load()); //Reported before playback starts (The timer reports the changes made by the audio thread)
 }
 
 void MultiPluginAudioProcessor::releaseResources()
@@ -126,18 +213,28 @@ bool MultiPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    //Any layout is supported (Mono, stereo, surround like 5.1 or 7.1.4, ambisonics or discrete channels) as long as it has
+    //between 1 and maximumNumChannels channels. Every DSP process keeps its state per channel, so the cost grows linearly.
+    const auto numOutputChannels = layouts.getMainOutputChannelSet().size();
+
+    if (numOutputChannels < 1 || numOutputChannels > maximumNumChannels)
         return false;
 
     // This checks if the input layout matches the output layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    //The sidechain can be off, mono or the same layout as the main bus (Every channel is keyed by the key channel with the same
+    //index, a mono key keys every channel). A stereo key is only accepted on a stereo main bus, on a surround or ambisonic bus
+    //its two channels would not match the channels they key
+    if (layouts.inputBuses.size() > sidechainBus)
+    {
+        const auto sidechain = layouts.getChannelSet(true, sidechainBus);
+
+        if (! sidechain.isDisabled() && sidechain != juce::AudioChannelSet::mono() && sidechain != layouts.getMainInputChannelSet())
+            return false;
+    }
    #endif
 
     return true;
@@ -145,8 +242,58 @@ bool MultiPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 }
 #endif
 
-void MultiPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void MultiPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    processSamples(buffer, floatEngine);
+}
+
+void MultiPluginAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
 {
+    processSamples(buffer, doubleEngine);
+}
+
+bool MultiPluginAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+namespace
+{
+    template <typename SampleType>
+    float getRmsLevel(const juce::dsp::AudioBlock<SampleType>& block) noexcept //RMS of every channel of a block together (Used by the meters)
+    {
+        SampleType sum = 0;
+
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+        {
+            const auto* samples = block.getChannelPointer(channel);
+
+            for (size_t i = 0; i < block.getNumSamples(); ++i)
+                sum += samples[i] * samples[i];
+        }
+
+        return (float) std::sqrt(sum / (SampleType) juce::jmax((size_t) 1, block.getNumChannels() * block.getNumSamples()));
+    }
+
+    template <typename SampleType>
+    float getPeakLevel(const juce::dsp::AudioBlock<SampleType>& block) noexcept //Loudest sample of every channel of a block
+    {
+        const auto range = block.findMinAndMax();
+        return (float) juce::jmax(-range.getStart(), range.getEnd());
+    }
+}
+
+template <typename SampleType>
+void MultiPluginAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer, PluginEngine<SampleType>& engine)
+{
+   #if MULTIPLUGIN_PROFILING
+    const CallbackProfiler::ScopedBlock profilerScope { profiler, buffer.getNumSamples() }; //Times the whole block, silent ones included
+   #endif
+
+   #if MULTIPLUGIN_RT_CHECK
+    const RealtimeCheck::ScopedRealtimeThread realtimeCheck; //Reports every allocation, lock and blocking call until the end of the block
+   #endif
+
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -159,38 +306,101 @@ void MultiPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     //https://docs.juce.com/master/tutorial_dsp_introduction.html
     //The loop was not used as it caused distortion of the signal for uknown reasons
 
-    auto audioBlock = juce::dsp::AudioBlock<float>(buffer); //Creates an audioblock that points to the buffer
-    auto context = juce::dsp::ProcessContextReplacing<float>(audioBlock); //Processes the audioblock and replaces it (https://docs.juce.com/master/structdsp_1_1ProcessContextReplacing.html)
+    auto audioBlock = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, (size_t) getMainBusNumOutputChannels()); //Creates an audioblock that points to the channels of the main bus
+
+    //Sidechain (The detector reads the channels of the bus in place, so nothing is copied. Empty when the bus is disabled)
+    juce::dsp::AudioBlock<const SampleType> sidechainBlock;
+    const auto numSidechainChannels = getChannelCountOfBus(true, sidechainBus);
+
+    if (numSidechainChannels > 0)
+        sidechainBlock = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock((size_t) getChannelIndexInProcessBlockBuffer(true, sidechainBus, 0),
+                                                                                         (size_t) numSidechainChannels);
  
     
-    switch (pluginType)
+    const auto program = pendingProgram.exchange(-1, std::memory_order_acquire);
+
+    if (program >= 0) //Program change: the preset goes to the DSP processes in this block and is held until the timer has sent it to the parameters
     {
-    case 1: //Filter
-        MultiPluginAudioProcessor::filterSetType(); //Sets the type
-        filter.setCutoffFrequency(filterFrequency); //Sets the value of the frequency
-        filter.setResonance(filterResonance); //Sets the value of the resonance
-
-        filter.process(context); //Initialazes the process of the filter
-        break;
-    case 2: //Compressor
-        compressor.setAttack(compressorAttack); //Sets the value of the attack
-        compressor.setRatio(compressorRatio); //Sets the value of the ratio
-        compressor.setRelease(compressorRelease); //Sets the value of the release
-        compressor.setThreshold(compressorThreshold); //Sets the value of the threshold
-        gain.setGainDecibels(gainGain); //Sets the value of the gain
-
-        compressor.process(context); //Initialazes the process of the compressor
-        gain.process(context); //Initialazes the process of the gain
-        break;
-    default: // Default is the default state of the switch case. If none of the above apply this is the state that the switch case is going to be in. In that case its the same as case 1 which is the filter.
-        MultiPluginAudioProcessor::filterSetType();
-        filter.setCutoffFrequency(filterFrequency);
-        filter.setResonance(filterResonance);
-
-        filter.process(context); //Initialazes the process of the filter
-        break;
+        updateProcessors(parameterCache.hold(presetBank.getSnapshot(program)));
+        heldProgram = program;
     }
-    
+    else if (heldProgram >= 0 && programSent.load(std::memory_order_acquire) == heldProgram) //The parameters have the program now
+    {
+        programSent.store(-1);
+        heldProgram = -1;
+        parameterCache.release();
+        parametersChanged = true;
+    }
+
+    if (parametersChanged.exchange(false)) //The DSP processes are only updated when a parameter actually moved
+        updateProcessors(parameterCache.update());
+
+    //Meters and analyzer (The levels are only measured while the editor is open, publishing never blocks)
+    const auto inputPeak = getPeakLevel(audioBlock);
+    const auto isMetering = meteringEnabled.load(std::memory_order_relaxed);
+    MeterFrame meterFrame;
+
+    if (isMetering)
+    {
+        meterFrame.inputPeak = inputPeak;
+        meterFrame.inputRms = getRmsLevel(audioBlock);
+    }
+
+    //Silence detection (Once the input has been silent for longer than the tail, the output is silent too and the block is only cleared.
+    //While the compressor is keyed, the key counts as input too, so a loud key over a silent input keeps the envelope moving)
+    const auto isKeyed = numSidechainChannels > 0 && parameterCache.getBool(ParameterCache::compressorSidechain);
+    const auto keyPeak = isKeyed ? getPeakLevel(sidechainBlock) : 0.0f;
+
+    if (juce::jmax(inputPeak, keyPeak) <= (float) silenceThreshold)
+    {
+        silentSamples += (juce::int64) buffer.getNumSamples();
+
+        if (silentSamples > tailLengthSamples)
+        {
+            audioBlock.clear();
+            isSuspended = true;
+
+            if (isMetering)
+                meterFifo.push(meterFrame); //Silent output and no gain reduction
+            if (analyzerEnabled.load(std::memory_order_relaxed))
+                analyzerFifo.push(audioBlock); //The spectrum falls back to the floor
+
+            return;
+        }
+    }
+    else
+    {
+        silentSamples = 0;
+
+        if (isSuspended) //The state of the processes has decayed while suspended, a reset makes it exactly zero
+        {
+            engine.reset();
+            isSuspended = false;
+        }
+    }
+
+    //Tempo and position of the host for the synced LFO (Read once per block, the LFO keeps the last tempo when the host gives none)
+    if (auto* playHead = getPlayHead())
+    {
+        if (const auto position = playHead->getPosition())
+        {
+            const auto ppqPosition = position->getPpqPosition();
+            engine.setTempo(position->getBpm().orFallback(0.0), ppqPosition.orFallback(0.0), position->getIsPlaying() && ppqPosition.hasValue());
+        }
+    }
+
+    engine.process(parameterCache, audioBlock, sidechainBlock); //Runs the selected mode (Filter, compressor or chain)
+
+    if (isMetering)
+    {
+        meterFrame.outputPeak = getPeakLevel(audioBlock);
+        meterFrame.outputRms = getRmsLevel(audioBlock);
+        meterFrame.compressorGain = (float) engine.getCompressorGain(parameterCache);
+        meterFifo.push(meterFrame);
+    }
+
+    if (analyzerEnabled.load(std::memory_order_relaxed))
+        analyzerFifo.push(audioBlock); //The FFT runs in the editor
 }
 
 //==============================================================================
@@ -207,42 +417,55 @@ juce::AudioProcessorEditor* MultiPluginAudioProcessor::createEditor()
 //==============================================================================
 void MultiPluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    pluginState.save(destData); //Versioned binary block with every parameter
 }
 
 void MultiPluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    pluginState.restore(data, sizeInBytes); //Binary block or XML, the listeners update the DSP processes
 }
 
 
 void MultiPluginAudioProcessor::reset() //Function to reset the properties of the plugin
 {
-    filter.reset(); //Filter
-    compressor.reset(); //Compressor
-    gain.reset(); //Gain
+   #if MULTIPLUGIN_RT_CHECK
+    const RealtimeCheck::ScopedRealtimeThread realtimeCheck; //Hosts can call it from the audio thread
+   #endif
+
+    if (isUsingDoublePrecision()) //Engine in use
+        doubleEngine.reset();
+    else
+        floatEngine.reset();
 }
 
-void MultiPluginAudioProcessor::filterSetType() //Switch case for selecting the filter type
+void MultiPluginAudioProcessor::updateProcessors(ParameterCache::Mask changed) //Function that sends the values of the changed parameters to the DSP processes
 {
-    switch (filterType) //Switch was used instead of if as it looks nicer and it was autocompleted which helped eliminating misstyping in the process
-    {
-    case 1: //Low Pass
-        filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass); //The function sets the type of the filter
-        break;
-    case 2: //Band Pass
-        filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass); 
-        break;
-    case 3: //High Pass
-        filter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
-        break;
-    default: //Low Pass
-        filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-        break;
-    }
+    if (isUsingDoublePrecision()) //Only the engine in use gets the parameters, prepareToPlay sends all of them again when the precision changes
+        doubleEngine.update(parameterCache, changed);
+    else
+        floatEngine.update(parameterCache, changed);
+
+    //Latency
+    constexpr auto latencyParameters = ParameterCache::bit(ParameterCache::pluginType) | ParameterCache::bit(ParameterCache::filterOversampling)
+                                     | ParameterCache::bit(ParameterCache::filterOversamplingType) | ParameterCache::bit(ParameterCache::compressorLookahead)
+                                     | ParameterCache::bit(ParameterCache::compressorMultiband) | ParameterCache::bit(ParameterCache::chainFilter)
+                                     | ParameterCache::bit(ParameterCache::chainCompressor);
+    if ((changed & latencyParameters) != 0)
+        MultiPluginAudioProcessor::updateLatency(); //Computes the new latency
+    //Tail (Only a few divisions, so it is recomputed for any change)
+    const auto tail = isUsingDoublePrecision() ? doubleEngine.getTailLengthSeconds(parameterCache) : floatEngine.getTailLengthSeconds(parameterCache);
+    tailLengthSeconds = tail;
+    tailLengthSamples = (juce::int64) std::ceil(tail * multiPluginSampleRate);
+}
+
+void MultiPluginAudioProcessor::parameterChanged(const juce::String&, float) //Called by the parameters from any thread, so it only sets a flag
+{
+    parametersChanged = true;
+}
+
+void MultiPluginAudioProcessor::updateLatency() //Computes the latency of the stages in use, prepareToPlay or the timer report it to the host
+{
+    latencySamples = isUsingDoublePrecision() ? doubleEngine.getLatencyInSamples(parameterCache) : floatEngine.getLatencyInSamples(parameterCache);
 }
 
 //==============================================================================
@@ -12,11 +12,21 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "PluginParameters.h"
+#include "ParameterCache.h"
+#include "PluginEngine.h"
+#include "MeterFifo.h"
+#include "AnalyzerFifo.h"
+#include "CallbackProfiler.h"
+#include "PluginState.h"
+#include "PresetBank.h"
 
 //==============================================================================
 /**
 */
-class MultiPluginAudioProcessor  : public juce::AudioProcessor
+class MultiPluginAudioProcessor  : public juce::AudioProcessor,
+                                   private juce::AudioProcessorValueTreeState::Listener, //Inherited class for knowing when a parameter changed
+                                   private juce::Timer //Inherited class for sending program changes to the parameters and the latency to the host
 {
 public:
     //==============================================================================
@@ -32,6 +42,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override; //64 bit path for the hosts that ask for it
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -56,30 +68,71 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    //Plugin Type
-    int pluginType = 1;
-    //Filter
-    float filterFrequency = 400.0; //Frequency
-    float filterResonance = 1.0; //Resonance
-    int filterType = 1; //Type
-    //Compressor
-    float compressorAttack = 0; //Attack
-    float compressorRatio = 1; //Ratio
-    float compressorRelease = 0; //Release
-    float compressorThreshold = 0; //Threshold
-    //Gain
-    float gainGain = 0;
+    //Parameters (Shared with the editor and the host. The audio thread only reads them through the atomic values below)
+    juce::AudioProcessorValueTreeState parameters;
+
+    //Meters
+    MeterFifo& getMeterFifo() noexcept { return meterFifo; } //Levels of every block, read by the editor
+    void setMeteringEnabled(bool shouldBeEnabled) noexcept { meteringEnabled = shouldBeEnabled; } //Set by the editor while it is open
+    AnalyzerFifo& getAnalyzerFifo() noexcept { return analyzerFifo; } //Output of every block, read by the spectrum analyzer
+    void setAnalyzerEnabled(bool shouldBeEnabled) noexcept { analyzerEnabled = shouldBeEnabled; } //Set by the editor while the analyzer is shown
+
+   #if MULTIPLUGIN_PROFILING
+    //Profiling
+    CallbackProfiler& getProfiler() noexcept { return profiler; } //Load of every block, read by the editor and the log
+   #endif
 
 private:
     void reset() override; //Function for reseting the plugin processes
-    void filterSetType(); //Function to reset the properties of the plugin
+    void updateLatency(); //Function that computes the latency of the oversampling and of the lookahead
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer, PluginEngine<SampleType>& engine); //Function that runs one of the engines on a buffer (Shared by both processBlock)
+    void updateProcessors(ParameterCache::Mask changed); //Function that sends the values of the changed parameters to the DSP processes
+    void parameterChanged(const juce::String& parameterID, float newValue) override; //Overriding listener function from the class AudioProcessorValueTreeState::Listener
+    void timerCallback() override; //Overriding timer function from the class Timer
+
+    PluginState pluginState { parameters }; //Binary state of the parameters for the host (Built after the parameters)
+    ParameterCache parameterCache; //Last values of the parameters sent to the DSP processes (Only used by the audio thread after the constructor)
+    std::atomic<bool> parametersChanged { true }; //Set when any parameter moved, cleared by the audio thread once the DSP processes got the new values
+
+    //Programs (The host picks a preset from any thread, the next block applies it and the timer sends it to the parameters of the host)
+    PresetBank presetBank { parameters }; //Factory and user presets, parsed once
+    std::atomic<int> currentProgram { 0 }; //Last program picked by the host
+    std::atomic<int> pendingProgram { -1 }; //Program waiting for the next block (The timer takes it back once the parameters have it)
+    std::atomic<int> programToSend { -1 }; //Program the parameters of the host do not have yet (Sent by the timer)
+    std::atomic<int> programSent { -1 }; //Program the timer has sent to the parameters, lets the cache follow the parameters again
+    std::atomic<int> latencySamples { 0 }; //Latency of the stages in use, reported to the host by prepareToPlay and by the timer
+    int heldProgram = -1; //Program held in the parameter cache (Only used by the audio thread)
+
+    //DSP engines (Only the one matching the processing precision of the host is prepared and runs)
+    PluginEngine<float> floatEngine;
+    PluginEngine<double> doubleEngine;
+
+    MeterFifo meterFifo; //Levels sent from the audio thread to the editor
+    std::atomic<bool> meteringEnabled { false }; //The audio thread only measures the levels while it is set
+    AnalyzerFifo analyzerFifo; //Output sent from the audio thread to the spectrum analyzer
+    std::atomic<bool> analyzerEnabled { false }; //The audio thread only copies the output while it is set
+
+   #if MULTIPLUGIN_PROFILING
+    CallbackProfiler profiler; //Times every block against its deadline
+    bool profilingLogEnabled = false; //Set by the MULTIPLUGIN_PROFILING_LOG environment variable
+    int timerCallbacksSinceLog = 0; //The timer writes the statistics to the log every profilingLogInterval callbacks
+    juce::uint64 overrunsLogged = 0; //Overruns already in the log
+    static constexpr int profilingLogInterval = 30 * 10; //10 seconds
+   #endif
+
+    static constexpr int maximumNumChannels = 64; //Largest layout accepted (Up to 7th order ambisonics)
+    static constexpr int sidechainBus = 1; //Index of the sidechain among the input buses (Disabled until the host routes a track to it)
 
-    juce::dsp::StateVariableTPTFilter<float> filter; //State Variable TPT Filter
-    juce::dsp::Compressor<float> compressor; //Compressor
-    juce::dsp::Gain<float> gain; //Gain
+    //Silence detection (Only used by the audio thread, apart from the tail length that the host reads)
+    static constexpr double silenceThreshold = 1.0e-6; //Input level counted as silence (-120 dB)
+    std::atomic<double> tailLengthSeconds { 0.0 }; //Tail of the stages in use, reported by getTailLengthSeconds()
+    juce::int64 tailLengthSamples = 0; //Same tail at the sample rate of the host
+    juce::int64 silentSamples = 0; //Samples of silent input since the last sound
+    bool isSuspended = false; //Set while the blocks are only cleared
 
     float multiPluginSampleRate; //Creating a samplerate variable where the samplerate is going to be saved for the processing
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiPluginAudioProcessor)
-};
\ No newline at end of file
+};
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    This file contains the saved state of the plugin.
+
+    Every number is written in little endian, the entries are read straight from the memory given by the host.
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+
+//==============================================================================
+PluginState::PluginState(juce::AudioProcessorValueTreeState& parametersToUse)
+    : parameters(parametersToUse)
+{
+    for (auto* parameter : parameters.processor.getParameters())
+        if (auto* rangedParameter = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            entries.push_back({ hashParameterID(rangedParameter->getParameterID().toRawUTF8()), rangedParameter });
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.idHash < b.idHash; });
+
+    for (size_t i = 1; i < entries.size(); ++i)
+        jassert(entries[i - 1].idHash != entries[i].idHash); //Two IDs have the same hash, one of them has to be renamed
+
+    values.resize(entries.size());
+}
+
+//==============================================================================
+void PluginState::save(juce::MemoryBlock& destData) const
+{
+   #if MULTIPLUGIN_XML_STATE
+    if (auto xml = parameters.copyState().createXml())
+        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+   #else
+    destData.setSize(headerSize + entries.size() * entrySize);
+    juce::MemoryOutputStream stream(destData, false);
+
+    stream.writeInt((int) magic);
+    stream.writeShort((short) version);
+    stream.writeShort((short) entries.size());
+
+    for (auto& entry : entries)
+    {
+        stream.writeInt((int) entry.idHash);
+        stream.writeFloat(entry.parameter->convertFrom0to1(entry.parameter->getValue())); //Plain value
+    }
+   #endif
+}
+
+bool PluginState::restore(const void* data, int sizeInBytes)
+{
+    if (data == nullptr || sizeInBytes < (int) headerSize)
+        return false;
+
+    if (juce::ByteOrder::littleEndianInt(data) == magic)
+        return restoreBinary(data, (size_t) sizeInBytes);
+
+    if (auto xml = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes)) //Debug format
+        return restoreXml(*xml);
+
+    return false;
+}
+
+//==============================================================================
+bool PluginState::restoreBinary(const void* data, size_t sizeInBytes)
+{
+    const auto* bytes = static_cast<const juce::uint8*>(data);
+    const auto numEntries = (size_t) juce::ByteOrder::littleEndianShort(bytes + 6);
+
+    if (headerSize + numEntries * entrySize > sizeInBytes) //Cut off
+        return false;
+
+    //Every parameter that is not in the state goes back to its default, so restoring a state always gives the same result
+    for (size_t i = 0; i < entries.size(); ++i)
+        values[i] = entries[i].parameter->convertFrom0to1(entries[i].parameter->getDefaultValue());
+
+    for (size_t i = 0; i < numEntries; ++i)
+    {
+        const auto* entryBytes = bytes + headerSize + i * entrySize;
+        const auto idHash = juce::ByteOrder::littleEndianInt(entryBytes);
+        const auto valueBits = juce::ByteOrder::littleEndianInt(entryBytes + 4);
+        float value;
+        std::memcpy(&value, &valueBits, sizeof(value));
+
+        const auto found = std::lower_bound(entries.begin(), entries.end(), idHash, [](const Entry& entry, juce::uint32 hash) { return entry.idHash < hash; });
+
+        if (found != entries.end() && found->idHash == idHash && std::isfinite(value)) //Parameters of newer versions are skipped
+            values[(size_t) std::distance(entries.begin(), found)] = value;
+    }
+
+    //Only the parameters that change notify the host and the listeners
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        auto* parameter = entries[i].parameter;
+        const auto newValue = parameter->convertTo0to1(values[i]);
+
+        if (newValue != parameter->getValue())
+            parameter->setValueNotifyingHost(newValue);
+    }
+
+    return true;
+}
+
+bool PluginState::restoreXml(const juce::XmlElement& xml)
+{
+    if (! xml.hasTagName(parameters.state.getType()))
+        return false;
+
+    parameters.replaceState(juce::ValueTree::fromXml(xml));
+    return true;
+}
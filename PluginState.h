@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    This file contains the saved state of the plugin.
+
+    The state is a small binary block: a header (magic, version, number of values) followed by one entry per
+    parameter with a hash of its ID and its plain value (Not the 0 to 1 value, so it survives a change of range).
+    Reading skips the hashes it does not know and keeps the default of the parameters that are missing, so a state
+    can be loaded by older and newer versions of the plugin. Newer versions only append data after the entries.
+
+    States written as XML (By hand or with MULTIPLUGIN_XML_STATE=1 for debugging) are also read.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MULTIPLUGIN_XML_STATE
+ #define MULTIPLUGIN_XML_STATE 0 //Set to 1 to save the state as readable XML instead of the binary format
+#endif
+
+//==============================================================================
+class PluginState
+{
+public:
+    explicit PluginState(juce::AudioProcessorValueTreeState& parametersToUse); //Builds the lookup from the ID hashes to the parameters
+
+    void save(juce::MemoryBlock& destData) const; //Binary format (Or XML with MULTIPLUGIN_XML_STATE)
+    bool restore(const void* data, int sizeInBytes); //Binary or XML, returns false when the data is neither
+
+    static constexpr juce::uint32 magic = 0x5453504d; //"MPST" in little endian
+    static constexpr int version = 1; //Increase when data is appended after the entries
+
+    static constexpr juce::uint32 hashParameterID(const char* parameterID) noexcept //FNV-1a hash of an ID (Checked for collisions in the constructor)
+    {
+        juce::uint32 hash = 2166136261u;
+
+        for (; *parameterID != 0; ++parameterID)
+            hash = (hash ^ (juce::uint8) *parameterID) * 16777619u;
+
+        return hash;
+    }
+
+private:
+    bool restoreBinary(const void* data, size_t sizeInBytes);
+    bool restoreXml(const juce::XmlElement& xml);
+
+    struct Entry
+    {
+        juce::uint32 idHash;
+        juce::RangedAudioParameter* parameter;
+    };
+
+    static constexpr size_t headerSize = 8; //Magic (4 bytes), version (2 bytes) and number of entries (2 bytes)
+    static constexpr size_t entrySize = 8; //ID hash (4 bytes) and plain value (4 bytes float)
+
+    juce::AudioProcessorValueTreeState& parameters;
+    std::vector<Entry> entries; //Every parameter, sorted by the hash of its ID
+    std::vector<float> values; //Values being restored (Allocated once so a restore does not allocate)
+};
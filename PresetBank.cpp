@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    This file contains the preset bank of the plugin, exposed to the host as its programs.
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+//==============================================================================
+namespace
+{
+    struct FactoryPreset
+    {
+        const char* name;
+        std::vector<std::pair<ParameterCache::Parameter, float>> values; //Plain values, every other parameter keeps its default
+    };
+
+    std::vector<FactoryPreset> getFactoryPresets()
+    {
+        using P = ParameterCache;
+
+        return {
+            { "Init", {} },
+            //Filter
+            { "Low Cut", { { P::pluginType, (float) PluginTypes::filter }, { P::filterType, (float) FilterTypes::highPass }, { P::filterFrequency, 80.0f } } },
+            { "Telephone", { { P::pluginType, (float) PluginTypes::filter }, { P::filterType, (float) FilterTypes::bandPass }, { P::filterFrequency, 1500.0f },
+                             { P::filterResonance, 2.0f } } },
+            { "Dark Low Pass", { { P::pluginType, (float) PluginTypes::filter }, { P::filterType, (float) FilterTypes::lowPass }, { P::filterFrequency, 2000.0f },
+                                 { P::filterResonance, 1.5f }, { P::filterOversampling, (float) OversamplingFactors::x2 } } },
+            { "Steep Low Cut", { { P::pluginType, (float) PluginTypes::filter }, { P::filterType, (float) FilterTypes::highPass }, { P::filterFrequency, 60.0f },
+                                 { P::filterSlope, (float) FilterSlopes::dB48 } } },
+            { "Ladder Sweep", { { P::pluginType, (float) PluginTypes::filter }, { P::filterTopology, (float) FilterTopologies::ladder }, { P::filterType, (float) FilterTypes::lowPass },
+                                { P::filterFrequency, 800.0f }, { P::filterResonance, 6.0f }, { P::filterOversampling, (float) OversamplingFactors::x2 } } },
+            { "Tempo Sweep", { { P::pluginType, (float) PluginTypes::filter }, { P::filterType, (float) FilterTypes::lowPass }, { P::filterFrequency, 800.0f },
+                               { P::filterResonance, 4.0f }, { P::filterSlope, (float) FilterSlopes::dB24 }, { P::filterLfoShape, (float) LfoShapes::triangle },
+                               { P::filterLfoSync, 1.0f }, { P::filterLfoDivision, (float) LfoDivisions::half }, { P::filterLfoCutoff, 2.0f } } },
+            { "Auto Wah", { { P::pluginType, (float) PluginTypes::filter }, { P::filterType, (float) FilterTypes::bandPass }, { P::filterFrequency, 300.0f },
+                            { P::filterResonance, 3.0f }, { P::filterEnvelopeAttack, 3.0f }, { P::filterEnvelopeRelease, 120.0f }, { P::filterEnvelopeCutoff, 3.0f } } },
+            //Compressor
+            { "Gentle Glue", { { P::pluginType, (float) PluginTypes::compressor }, { P::compressorThreshold, -18.0f }, { P::compressorRatio, 2.0f },
+                               { P::compressorAttack, 30.0f }, { P::compressorRelease, 200.0f }, { P::compressorLink, 1.0f } } },
+            { "Vocal Leveler", { { P::pluginType, (float) PluginTypes::compressor }, { P::compressorThreshold, -24.0f }, { P::compressorRatio, 4.0f },
+                                 { P::compressorAttack, 5.0f }, { P::compressorRelease, 120.0f }, { P::compressorLookahead, 2.0f }, { P::gainGain, 4.4f } } },
+            { "Peak Catcher", { { P::pluginType, (float) PluginTypes::compressor }, { P::compressorThreshold, -6.0f }, { P::compressorRatio, 10.0f },
+                                { P::compressorAttack, 0.01f }, { P::compressorRelease, 50.0f }, { P::compressorLookahead, 5.0f }, { P::compressorLink, 1.0f } } },
+            { "RMS Leveler", { { P::pluginType, (float) PluginTypes::compressor }, { P::compressorDetector, (float) CompressorDetectors::rms }, { P::compressorRmsWindow, 30.0f },
+                               { P::compressorThreshold, -20.0f }, { P::compressorRatio, 3.0f }, { P::compressorKnee, 6.0f }, { P::compressorAttack, 20.0f },
+                               { P::compressorRelease, 250.0f }, { P::compressorLink, 1.0f }, { P::compressorLinkAmount, 70.0f } } },
+            //Multiband Compressor
+            { "Multiband Master", { { P::pluginType, (float) PluginTypes::compressor }, { P::compressorMultiband, 1.0f }, { P::compressorBands, (float) CompressorBands::four },
+                                    { P::compressorCrossoverLow, 120.0f }, { P::compressorCrossoverMid, 1000.0f }, { P::compressorCrossoverHigh, 8000.0f },
+                                    { P::compressorBand1Threshold, -18.0f }, { P::compressorBand2Threshold, -14.0f }, { P::compressorBand3Threshold, -12.0f },
+                                    { P::compressorBand4Threshold, -10.0f }, { P::compressorRatio, 2.0f }, { P::compressorAttack, 10.0f },
+                                    { P::compressorRelease, 150.0f }, { P::compressorLink, 1.0f } } },
+            { "Multiband De-Mud", { { P::pluginType, (float) PluginTypes::compressor }, { P::compressorMultiband, 1.0f }, { P::compressorBands, (float) CompressorBands::three },
+                                    { P::compressorCrossoverLow, 250.0f }, { P::compressorCrossoverMid, 2500.0f }, { P::compressorBand2Threshold, -20.0f },
+                                    { P::compressorRatio, 3.0f }, { P::compressorAttack, 15.0f }, { P::compressorRelease, 100.0f } } },
+            //Chain
+            { "Clean Bus", { { P::pluginType, (float) PluginTypes::chain }, { P::chainOrder, (float) ChainOrders::filterCompressorGain },
+                             { P::filterType, (float) FilterTypes::highPass }, { P::filterFrequency, 30.0f }, { P::compressorThreshold, -12.0f },
+                             { P::compressorRatio, 2.0f }, { P::compressorAttack, 20.0f }, { P::compressorRelease, 150.0f }, { P::gainGain, 2.2f } } },
+            { "Loud And Dark", { { P::pluginType, (float) PluginTypes::chain }, { P::chainOrder, (float) ChainOrders::gainCompressorFilter },
+                                 { P::gainGain, 6.6f }, { P::compressorThreshold, -10.0f }, { P::compressorRatio, 6.0f }, { P::compressorAttack, 1.0f },
+                                 { P::compressorRelease, 80.0f }, { P::compressorLink, 1.0f }, { P::filterType, (float) FilterTypes::lowPass },
+                                 { P::filterFrequency, 9000.0f } } }
+        };
+    }
+}
+
+//==============================================================================
+PresetBank::PresetBank(juce::AudioProcessorValueTreeState& parametersToUse)
+{
+    for (int i = 0; i < ParameterCache::numParameters; ++i)
+    {
+        cachedParameters[(size_t) i] = parametersToUse.getParameter(ParameterCache::parameterIDs[i]);
+        jassert(cachedParameters[(size_t) i] != nullptr); //The ID is missing from createParameterLayout()
+        defaults[(size_t) i] = cachedParameters[(size_t) i]->convertFrom0to1(cachedParameters[(size_t) i]->getDefaultValue());
+    }
+
+    addFactoryPresets();
+    addUserPresets();
+}
+
+juce::File PresetBank::getUserPresetFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Multi-Plugin").getChildFile("Presets");
+}
+
+//==============================================================================
+void PresetBank::addFactoryPresets()
+{
+    for (auto& factoryPreset : getFactoryPresets())
+    {
+        Preset preset { factoryPreset.name, defaults };
+
+        for (auto& [parameter, value] : factoryPreset.values)
+            preset.values[(size_t) parameter] = quantise(parameter, value);
+
+        presets.push_back(std::move(preset));
+    }
+}
+
+void PresetBank::addUserPresets()
+{
+    auto files = getUserPresetFolder().findChildFiles(juce::File::findFiles, false, "*.xml");
+    files.sort(); //Same order on every system
+
+    for (auto& file : files)
+    {
+        auto xml = juce::parseXML(file);
+
+        if (xml == nullptr)
+            continue;
+
+        Preset preset { file.getFileNameWithoutExtension(), defaults };
+
+        for (auto* element : xml->getChildWithTagNameIterator("PARAM")) //Same elements as the value tree of the parameters
+        {
+            const auto id = element->getStringAttribute("id");
+
+            for (int i = 0; i < ParameterCache::numParameters; ++i)
+                if (id == ParameterCache::parameterIDs[i])
+                    preset.values[(size_t) i] = quantise(i, (float) element->getDoubleAttribute("value", defaults[(size_t) i]));
+        }
+
+        presets.push_back(std::move(preset));
+    }
+}
+
+float PresetBank::quantise(int parameterIndex, float plainValue) const
+{
+    auto* parameter = cachedParameters[(size_t) parameterIndex];
+    return parameter->convertFrom0to1(parameter->convertTo0to1(plainValue));
+}
+
+//==============================================================================
+void PresetBank::sendToParameters(int index)
+{
+    const auto& snapshot = getSnapshot(index);
+
+    for (size_t i = 0; i < cachedParameters.size(); ++i)
+    {
+        const auto newValue = cachedParameters[i]->convertTo0to1(snapshot[i]);
+
+        if (newValue != cachedParameters[i]->getValue()) //Only the parameters that change notify the host
+            cachedParameters[i]->setValueNotifyingHost(newValue);
+    }
+}
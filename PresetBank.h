@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    This file contains the preset bank of the plugin, exposed to the host as its programs.
+
+    The factory presets come first, followed by the user presets found in the user preset folder (XML files like the
+    debug format of PluginState, with one PARAM element per parameter). Every preset is parsed once when the bank is
+    built into a flat snapshot of plain values in the order of ParameterCache, so a program change only hands an
+    index to the audio thread, which copies the snapshot into the cache without allocating or locking. The parameters
+    that are missing from a preset keep their default value.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterCache.h"
+
+//==============================================================================
+class PresetBank
+{
+public:
+    explicit PresetBank(juce::AudioProcessorValueTreeState& parametersToUse); //Parses the factory presets and the user preset folder
+
+    int getNumPresets() const noexcept { return (int) presets.size(); }
+    const juce::String& getName(int index) const noexcept { return presets[(size_t) index].name; }
+    const ParameterCache::Snapshot& getSnapshot(int index) const noexcept { return presets[(size_t) index].values; } //Safe on the audio thread, the bank never changes after the constructor
+
+    void sendToParameters(int index); //Sets the parameters of the host to a preset (Message thread)
+
+    static juce::File getUserPresetFolder(); //Folder scanned for the user presets (*.xml)
+
+private:
+    struct Preset
+    {
+        juce::String name;
+        ParameterCache::Snapshot values;
+    };
+
+    void addFactoryPresets();
+    void addUserPresets();
+    float quantise(int parameterIndex, float plainValue) const; //Snaps a value to the range of its parameter, like the host parameter will
+
+    std::array<juce::RangedAudioParameter*, ParameterCache::numParameters> cachedParameters {}; //Parameters in the order of ParameterCache
+    ParameterCache::Snapshot defaults {}; //Default value of every parameter
+    std::vector<Preset> presets; //Factory presets, then user presets (Never changes after the constructor)
+};
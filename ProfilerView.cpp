@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    This file contains the profiler display of the editor (Only compiled with MULTIPLUGIN_PROFILING=1).
+
+  ==============================================================================
+*/
+
+#include "ProfilerView.h"
+
+#if MULTIPLUGIN_PROFILING
+
+//==============================================================================
+ProfilerView::ProfilerView(CallbackProfiler& profilerToUse)
+    : profiler(profilerToUse)
+{
+    setOpaque(true);
+}
+
+//==============================================================================
+void ProfilerView::update()
+{
+    if (++vBlanksSinceUpdate < updateInterval)
+        return;
+
+    vBlanksSinceUpdate = 0;
+    const auto newStatistics = profiler.getStatistics();
+
+    if (newStatistics.numBlocks == statistics.numBlocks && newStatistics.worstLoad == statistics.worstLoad)
+        return; //No block since the last read (Playback stopped), so there is nothing to repaint
+
+    statistics = newStatistics;
+    repaint();
+}
+
+void ProfilerView::mouseDown(const juce::MouseEvent& event)
+{
+    juce::ignoreUnused(event);
+    profiler.reset();
+    statistics = {};
+    repaint();
+}
+
+//==============================================================================
+void ProfilerView::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colour(0xff111111));
+
+    auto area = getLocalBounds().toFloat().reduced(4.0f);
+    const auto textArea = area.removeFromTop(14.0f);
+
+    //Summary
+    g.setColour(statistics.numOverruns > 0 ? juce::Colours::orangered : juce::Colours::lightgrey);
+    g.setFont(12.0f);
+    g.drawText("CPU " + statistics.toString(), textArea, juce::Justification::centredLeft, true);
+
+    //Histogram (Bars scaled to the largest bin, the line is the deadline)
+    const auto largestBin = *std::max_element(statistics.histogram.begin(), statistics.histogram.end());
+    const auto barWidth = area.getWidth() / (float) CallbackProfiler::numBins;
+
+    for (int bin = 0; bin < CallbackProfiler::numBins; ++bin)
+    {
+        const auto count = statistics.histogram[(size_t) bin];
+
+        if (count == 0)
+            continue;
+
+        const auto height = juce::jmax(1.0f, area.getHeight() * (float) count / (float) largestBin);
+        const auto isOverrun = (bin + 1) * CallbackProfiler::binWidth > 1.0 + 1.0e-9; //Bins past the deadline
+        g.setColour(isOverrun ? juce::Colours::orangered : juce::Colours::lightgreen);
+        g.fillRect(area.getX() + (float) bin * barWidth, area.getBottom() - height, juce::jmax(1.0f, barWidth - 1.0f), height);
+    }
+
+    const auto deadlineX = area.getX() + barWidth * (float) (1.0 / CallbackProfiler::binWidth);
+    g.setColour(juce::Colours::white.withAlpha(0.5f));
+    g.drawVerticalLine(juce::roundToInt(deadlineX), area.getY(), area.getBottom());
+}
+
+#endif
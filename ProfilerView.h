@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    This file contains the profiler display of the editor (Only compiled with MULTIPLUGIN_PROFILING=1).
+
+    Shows the histogram of the load of the blocks (Time of the block / deadline of the block) with the average, the
+    worst block and the number of overruns. The statistics are read from the CallbackProfiler of the processor a few
+    times per second, clicking the display clears them.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CallbackProfiler.h"
+
+#if MULTIPLUGIN_PROFILING
+
+//==============================================================================
+class ProfilerView  : public juce::Component
+{
+public:
+    explicit ProfilerView(CallbackProfiler& profilerToUse);
+
+    void paint(juce::Graphics& g) override;
+    void mouseDown(const juce::MouseEvent& event) override; //Clears the statistics
+
+private:
+    void update(); //Reads the statistics (Called on every vblank, only repaints every updateInterval vblanks)
+
+    static constexpr int updateInterval = 15; //Vblanks between two reads (About 4 per second at 60 Hz)
+
+    CallbackProfiler& profiler;
+    CallbackProfiler::Statistics statistics; //Last statistics read
+    int vBlanksSinceUpdate = 0;
+
+    juce::VBlankAttachment vBlankAttachment { this, [this] { update(); } }; //Declared last so it is detached before the statistics are deleted
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfilerView)
+};
+
+#endif
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    This file contains the realtime safety checker of the audio thread (Only compiled with MULTIPLUGIN_RT_CHECK=1).
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RealtimeCheck.h"
+
+#if MULTIPLUGIN_RT_CHECK
+
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <unistd.h>
+ #include <time.h>
+#endif
+
+//The state of the thread is read inside malloc, so it must not allocate on its first use (The initial-exec model never does)
+#if JUCE_GCC || JUCE_CLANG
+ #define MULTIPLUGIN_RT_CHECK_TLS __attribute__((tls_model("initial-exec")))
+#else
+ #define MULTIPLUGIN_RT_CHECK_TLS
+#endif
+
+//==============================================================================
+namespace
+{
+    constexpr int maximumReports = 16; //Calls printed with their stack trace, the others are only counted
+
+    thread_local int realtimeDepth MULTIPLUGIN_RT_CHECK_TLS = 0; //Nested ScopedRealtimeThread of this thread
+    thread_local bool isReporting MULTIPLUGIN_RT_CHECK_TLS = false; //Set while a report allocates and prints, so it is not reported itself
+
+    std::atomic<int> numViolations { 0 };
+    std::atomic<RealtimeCheck::FailureMode> failureMode { RealtimeCheck::FailureMode::report };
+
+    void report(const char* functionName) noexcept
+    {
+        isReporting = true;
+        const auto violation = ++numViolations;
+
+        if (violation <= maximumReports || failureMode == RealtimeCheck::FailureMode::abort)
+        {
+            std::fprintf(stderr, "Realtime violation %d: %s called on the audio thread\n%s\n", violation, functionName,
+                         juce::SystemStats::getStackBacktrace().toRawUTF8());
+            std::fflush(stderr);
+        }
+
+        if (failureMode == RealtimeCheck::FailureMode::abort)
+            std::abort();
+
+        isReporting = false;
+    }
+}
+
+//==============================================================================
+void RealtimeCheck::setFailureMode(FailureMode newMode) noexcept { failureMode = newMode; }
+int RealtimeCheck::getNumViolations() noexcept { return numViolations; }
+void RealtimeCheck::resetViolations() noexcept { numViolations = 0; }
+bool RealtimeCheck::isRealtimeThread() noexcept { return realtimeDepth > 0; }
+
+void RealtimeCheck::check(const char* functionName) noexcept
+{
+    if (realtimeDepth > 0 && ! isReporting)
+        report(functionName);
+}
+
+RealtimeCheck::ScopedRealtimeThread::ScopedRealtimeThread() noexcept { ++realtimeDepth; }
+RealtimeCheck::ScopedRealtimeThread::~ScopedRealtimeThread() noexcept { --realtimeDepth; }
+
+//==============================================================================
+#if JUCE_LINUX
+
+//Allocations of C (Every malloc() of an executable that links this file goes through these)
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+
+    void* malloc(size_t size)                          { RealtimeCheck::check("malloc"); return __libc_malloc(size); }
+    void* calloc(size_t count, size_t size)            { RealtimeCheck::check("calloc"); return __libc_calloc(count, size); }
+    void* realloc(void* pointer, size_t size)          { RealtimeCheck::check("realloc"); return __libc_realloc(pointer, size); }
+    void* aligned_alloc(size_t alignment, size_t size) { RealtimeCheck::check("aligned_alloc"); return __libc_memalign(alignment, size); }
+    void free(void* pointer)                           { RealtimeCheck::check("free"); __libc_free(pointer); }
+
+    int posix_memalign(void** pointer, size_t alignment, size_t size)
+    {
+        RealtimeCheck::check("posix_memalign");
+        *pointer = __libc_memalign(alignment, size);
+        return *pointer != nullptr || size == 0 ? 0 : ENOMEM;
+    }
+}
+
+//Locks and blocking calls (The originals are looked up once, the lookup uses no lock that goes through these functions)
+namespace
+{
+    void* findNext(std::atomic<void*>& next, const char* name) noexcept
+    {
+        auto* function = next.load(std::memory_order_relaxed);
+
+        if (function == nullptr)
+        {
+            function = dlsym(RTLD_NEXT, name);
+            next.store(function, std::memory_order_relaxed);
+        }
+
+        return function;
+    }
+}
+
+#define MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(returnType, name, parameters, arguments) \
+    static std::atomic<void*> next_##name { nullptr }; \
+    extern "C" returnType name parameters \
+    { \
+        RealtimeCheck::check(#name); \
+        return reinterpret_cast<returnType (*) parameters>(findNext(next_##name, #name)) arguments; \
+    }
+
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, pthread_mutex_lock, (pthread_mutex_t* mutex), (mutex))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, pthread_rwlock_rdlock, (pthread_rwlock_t* lock), (lock))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, pthread_rwlock_wrlock, (pthread_rwlock_t* lock), (lock))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, pthread_cond_wait, (pthread_cond_t* condition, pthread_mutex_t* mutex), (condition, mutex))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, pthread_cond_timedwait, (pthread_cond_t* condition, pthread_mutex_t* mutex, const timespec* time), (condition, mutex, time))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, pthread_join, (pthread_t thread, void** result), (thread, result))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, sem_wait, (sem_t* semaphore), (semaphore))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, nanosleep, (const timespec* duration, timespec* remaining), (duration, remaining))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(int, usleep, (useconds_t microseconds), (microseconds))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(unsigned int, sleep, (unsigned int seconds), (seconds))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(ssize_t, read, (int file, void* data, size_t size), (file, data, size))
+MULTIPLUGIN_RT_CHECK_BLOCKING_CALL(ssize_t, write, (int file, const void* data, size_t size), (file, data, size))
+
+#undef MULTIPLUGIN_RT_CHECK_BLOCKING_CALL
+
+#endif
+
+//==============================================================================
+//C++ allocations (On every platform. On Linux they go straight to the allocator of libc, so malloc() does not report them a second time)
+namespace
+{
+    void* allocate(std::size_t size) noexcept
+    {
+       #if JUCE_LINUX
+        return __libc_malloc(size == 0 ? 1 : size);
+       #else
+        return std::malloc(size == 0 ? 1 : size);
+       #endif
+    }
+
+    void deallocate(void* pointer) noexcept
+    {
+       #if JUCE_LINUX
+        __libc_free(pointer);
+       #else
+        std::free(pointer);
+       #endif
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    RealtimeCheck::check("operator new");
+
+    if (auto* pointer = allocate(size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    RealtimeCheck::check("operator new[]");
+
+    if (auto* pointer = allocate(size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept                { RealtimeCheck::check("operator delete"); deallocate(pointer); }
+void operator delete[](void* pointer) noexcept              { RealtimeCheck::check("operator delete[]"); deallocate(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept   { RealtimeCheck::check("operator delete"); deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { RealtimeCheck::check("operator delete[]"); deallocate(pointer); }
+
+#endif
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    This file contains the realtime safety checker of the audio thread (Only compiled with MULTIPLUGIN_RT_CHECK=1).
+
+    processBlock, reset and setCurrentProgram mark the calling thread as realtime for as long as they run. While a
+    thread is marked, every heap allocation or free, every mutex lock and every blocking call (Sleeping, waiting on a
+    condition, joining a thread, reading or writing a file descriptor) is reported with the stack trace of the call,
+    and counted so an automated run can fail on it (See the realtime suite of the benchmark).
+
+    The calls are caught by replacing them: the global operator new and delete on every platform, and on Linux also
+    malloc, free and the blocking pthread and POSIX calls (The originals are found with dlsym(RTLD_NEXT)). In an
+    executable that links this file, like the benchmark, the replacements take every call of the process. A plugin is
+    loaded with dlopen() and the loader looks in the host and libc first, so on Linux a plugin build only checks its
+    own calls, and only when it is linked with -Wl,-Bsymbolic-functions. The host and the C++ library are never
+    checked from a plugin. It is meant for debug and test builds, never for a release: every call pays for the check.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef MULTIPLUGIN_RT_CHECK
+ #define MULTIPLUGIN_RT_CHECK 0
+#endif
+
+#if MULTIPLUGIN_RT_CHECK
+
+//==============================================================================
+namespace RealtimeCheck
+{
+    enum class FailureMode
+    {
+        report, //Prints the call with its stack trace and carries on (The first maximumReports calls only)
+        abort //Prints the call and aborts, so a debugger stops on it
+    };
+
+    void setFailureMode(FailureMode newMode) noexcept;
+    int getNumViolations() noexcept; //Calls caught since the start or since the last reset
+    void resetViolations() noexcept;
+
+    bool isRealtimeThread() noexcept; //True inside a ScopedRealtimeThread
+    void check(const char* functionName) noexcept; //Reports the call when the calling thread is realtime (Used by the replaced functions)
+
+    //Marks the calling thread as realtime until the end of the scope (Scopes can be nested)
+    struct ScopedRealtimeThread
+    {
+        ScopedRealtimeThread() noexcept;
+        ~ScopedRealtimeThread() noexcept;
+
+        ScopedRealtimeThread(const ScopedRealtimeThread&) = delete;
+        ScopedRealtimeThread& operator=(const ScopedRealtimeThread&) = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,407 @@
+/*
+  ==============================================================================
+
+    This file contains the headless offline renderer of the plugin.
+
+    It creates MultiPluginAudioProcessor without its editor and streams WAV/FLAC/AIFF files through processBlock in
+    fixed size blocks. Every worker thread owns one processor and takes the next file from a shared list, so many
+    files are processed in parallel across the cores. WAV and AIFF files are read through a memory mapped reader that
+    only maps a window of the file at a time, the other formats are streamed from disk, so huge files never sit fully
+    in RAM.
+
+    Usage: Multi-Plugin-Render [options] <input files or folders...>
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../../Source/PluginProcessor.h"
+
+//==============================================================================
+namespace
+{
+    constexpr juce::int64 mappedWindowSamples = 1 << 20; //Number of samples mapped at a time by the memory mapped reader
+
+    struct RenderSettings //Everything read from the command line
+    {
+        juce::StringPairArray parameterValues; //--set parameterID=value
+        juce::File stateFile; //--state
+        juce::File outputFolder; //--out
+        int blockSize = 512; //--block
+        int numWorkers = juce::SystemStats::getNumCpus(); //--jobs
+        juce::Array<juce::File> inputFiles;
+    };
+
+    juce::CriticalSection outputLock; //The workers print from different threads
+
+    void print(const juce::String& text)
+    {
+        const juce::ScopedLock sl(outputLock);
+        std::cout << text << std::endl;
+    }
+
+    void printUsage()
+    {
+        print("Usage: Multi-Plugin-Render [options] <input files or folders...>\n"
+              "\n"
+              "  --set <parameterID>=<value>  Sets a parameter, can be used many times. The value is a plain number\n"
+              "                               or the name of a choice (e.g. --set \"filterType=High Pass\")\n"
+              "  --state <file>               Loads a state file of the plugin before the --set values are applied\n"
+              "  --out <folder>               Output folder (Default: next to every input file with \"_processed\" added)\n"
+              "  --block <samples>            Size of the blocks sent to processBlock (Default: 512)\n"
+              "  --jobs <count>               Number of worker threads (Default: number of cores)\n"
+              "  --list-parameters            Prints the IDs, the ranges and the defaults of the parameters");
+    }
+
+    //==============================================================================
+    void listParameters()
+    {
+        MultiPluginAudioProcessor processor;
+
+        for (auto* parameter : processor.getParameters())
+        {
+            if (auto* rangedParameter = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            {
+                auto line = rangedParameter->getParameterID().paddedRight(' ', 24);
+                const auto& range = rangedParameter->getNormalisableRange();
+
+                if (auto* choiceParameter = dynamic_cast<juce::AudioParameterChoice*>(rangedParameter))
+                    line << "choice: " << choiceParameter->choices.joinIntoString(" | ");
+                else
+                    line << range.start << " .. " << range.end;
+
+                line << "  (default " << rangedParameter->getText(rangedParameter->getDefaultValue(), 64) << ")";
+                print(line);
+            }
+        }
+    }
+
+    bool applyParameters(MultiPluginAudioProcessor& processor, const RenderSettings& settings, juce::String& error) //State file first, then every --set
+    {
+        if (settings.stateFile != juce::File())
+        {
+            if (auto xml = juce::parseXML(settings.stateFile)) //State written as XML by hand or by the debug format
+            {
+                processor.parameters.replaceState(juce::ValueTree::fromXml(*xml));
+            }
+            else
+            {
+                juce::MemoryBlock data;
+
+                if (! settings.stateFile.loadFileAsData(data))
+                {
+                    error = "Cannot read the state file " + settings.stateFile.getFullPathName();
+                    return false;
+                }
+
+                processor.setStateInformation(data.getData(), (int) data.getSize());
+            }
+        }
+
+        for (auto& parameterID : settings.parameterValues.getAllKeys())
+        {
+            auto* parameter = processor.parameters.getParameter(parameterID);
+
+            if (parameter == nullptr)
+            {
+                error = "Unknown parameter " + parameterID + " (use --list-parameters)";
+                return false;
+            }
+
+            const auto text = settings.parameterValues[parameterID];
+            const auto normalisedValue = text.containsOnly("0123456789.-+eE") ? parameter->convertTo0to1(text.getFloatValue()) //Plain value
+                                                                              : parameter->getValueForText(text); //Choice name
+            parameter->setValueNotifyingHost(normalisedValue);
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    struct FileResult
+    {
+        bool succeeded = false;
+        juce::String message;
+        double audioSeconds = 0.0, wallSeconds = 0.0;
+    };
+
+    bool readBlock(juce::AudioFormatReader& reader, juce::MemoryMappedAudioFormatReader* mappedReader,
+                   juce::AudioBuffer<float>& buffer, int numSamples, juce::int64 startSample) //Moves the mapped window when the block is outside of it
+    {
+        if (mappedReader != nullptr)
+        {
+            const juce::Range<juce::int64> neededSection(startSample, startSample + numSamples);
+
+            if (! mappedReader->getMappedSection().contains(neededSection))
+                if (! mappedReader->mapSectionOfFile({ startSample, juce::jmin(reader.lengthInSamples, startSample + juce::jmax(mappedWindowSamples, (juce::int64) numSamples)) }))
+                    return false;
+        }
+
+        return reader.read(&buffer, 0, numSamples, startSample, true, true);
+    }
+
+    FileResult renderFile(MultiPluginAudioProcessor& processor, juce::AudioFormatManager& formatManager,
+                          const juce::File& inputFile, const juce::File& outputFile, int blockSize)
+    {
+        FileResult result;
+        auto* format = formatManager.findFormatForFileExtension(inputFile.getFileExtension());
+
+        if (format == nullptr)
+        {
+            result.message = "Unsupported file format";
+            return result;
+        }
+
+        //Reader (Memory mapped when the format supports it, otherwise streamed from the file)
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(format->createMemoryMappedReader(inputFile));
+        std::unique_ptr<juce::AudioFormatReader> streamedReader;
+
+        if (mappedReader == nullptr)
+            streamedReader.reset(formatManager.createReaderFor(inputFile));
+
+        juce::AudioFormatReader* reader = mappedReader != nullptr ? static_cast<juce::AudioFormatReader*>(mappedReader.get()) : streamedReader.get();
+
+        if (reader == nullptr)
+        {
+            result.message = "Cannot open the file";
+            return result;
+        }
+
+        const auto numChannels = (int) reader->numChannels;
+        const auto sampleRate = reader->sampleRate;
+        const auto lengthInSamples = reader->lengthInSamples;
+
+        //Processor (Same layout as the file on the main input and output)
+        processor.releaseResources();
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        layout.outputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+
+        if (! processor.setBusesLayout(layout))
+        {
+            result.message = juce::String(numChannels) + " channels are not supported by the plugin";
+            return result;
+        }
+
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        //Writer (Same format, bit depth and sample rate as the input)
+        auto bitsPerSample = (int) reader->bitsPerSample;
+
+        if (! format->getPossibleBitDepths().contains(bitsPerSample))
+            bitsPerSample = format->getPossibleBitDepths().getLast();
+
+        outputFile.deleteFile();
+        auto outputStream = std::make_unique<juce::FileOutputStream>(outputFile);
+
+        if (outputStream->failedToOpen())
+        {
+            result.message = "Cannot create " + outputFile.getFullPathName();
+            return result;
+        }
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(outputStream.get(), sampleRate, (unsigned int) numChannels,
+                                                                                bitsPerSample, reader->metadataValues, 0));
+
+        if (writer == nullptr)
+        {
+            result.message = "Cannot create a writer for " + outputFile.getFullPathName();
+            return result;
+        }
+
+        outputStream.release(); //The writer owns the stream now
+
+        //Processing (The latency of the plugin is removed from the start of the output and the tail is rendered after the end of the input.
+        //The tail already includes the latency, so the output is the length of the input plus the time the plugin rings)
+        const auto latencySamples = (juce::int64) processor.getLatencySamples();
+        const auto tailSamples = (juce::int64) std::ceil(processor.getTailLengthSeconds() * sampleRate);
+        const auto totalSamples = lengthInSamples + tailSamples;
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midiMessages;
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        for (juce::int64 position = 0; position < totalSamples; position += blockSize)
+        {
+            const auto numSamples = (int) juce::jmin((juce::int64) blockSize, totalSamples - position);
+            const auto numInputSamples = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, lengthInSamples - position);
+
+            buffer.clear();
+
+            if (numInputSamples > 0 && ! readBlock(*reader, mappedReader.get(), buffer, numInputSamples, position))
+            {
+                result.message = "Read error at sample " + juce::String(position);
+                return result;
+            }
+
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples); //Refers to the buffer, the last block can be shorter
+            processor.processBlock(block, midiMessages);
+
+            const auto skippedSamples = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latencySamples - position);
+
+            if (skippedSamples < numSamples)
+                writer->writeFromAudioSampleBuffer(block, skippedSamples, numSamples - skippedSamples);
+        }
+
+        result.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        result.audioSeconds = (double) lengthInSamples / sampleRate;
+        result.succeeded = true;
+        return result;
+    }
+
+    //==============================================================================
+    class RenderWorker  : public juce::Thread //One processor per worker, the files are taken from a shared list
+    {
+    public:
+        RenderWorker(int index, const RenderSettings& s, std::atomic<int>& next, std::atomic<int>& failed)
+            : juce::Thread("Render Worker " + juce::String(index)), settings(s), nextFile(next), numFailedFiles(failed)
+        {
+            formatManager.registerBasicFormats();
+        }
+
+        void run() override
+        {
+            MultiPluginAudioProcessor processor;
+            processor.setNonRealtime(true);
+
+            juce::String error;
+
+            if (! applyParameters(processor, settings, error))
+            {
+                print("Error: " + error);
+                numFailedFiles += settings.inputFiles.size();
+                nextFile = settings.inputFiles.size(); //Stops the other workers as well, every worker would fail the same way
+                return;
+            }
+
+            for (auto index = nextFile++; index < settings.inputFiles.size() && ! threadShouldExit(); index = nextFile++)
+            {
+                const auto& inputFile = settings.inputFiles.getReference(index);
+                const auto outputName = inputFile.getFileNameWithoutExtension() + "_processed" + inputFile.getFileExtension();
+                const auto outputFile = (settings.outputFolder != juce::File() ? settings.outputFolder : inputFile.getParentDirectory()).getChildFile(outputName);
+
+                const auto result = renderFile(processor, formatManager, inputFile, outputFile, settings.blockSize);
+
+                if (result.succeeded)
+                    print(inputFile.getFileName() + ": " + juce::String(result.audioSeconds, 2) + " s of audio in " + juce::String(result.wallSeconds, 3)
+                          + " s (" + juce::String(result.audioSeconds / juce::jmax(result.wallSeconds, 1.0e-9), 1) + "x realtime) -> " + outputFile.getFullPathName());
+                else
+                    print(inputFile.getFileName() + ": FAILED (" + result.message + ")");
+
+                if (! result.succeeded)
+                    ++numFailedFiles;
+            }
+        }
+
+    private:
+        const RenderSettings& settings;
+        std::atomic<int>& nextFile;
+        std::atomic<int>& numFailedFiles;
+        juce::AudioFormatManager formatManager; //Each worker has its own, the readers are not shared
+    };
+
+    //==============================================================================
+    bool parseArguments(const juce::StringArray& arguments, RenderSettings& settings)
+    {
+        for (int i = 0; i < arguments.size(); ++i)
+        {
+            const auto& argument = arguments[i];
+            const auto hasValue = i + 1 < arguments.size();
+
+            if (argument == "--set" && hasValue && arguments[i + 1].contains("="))
+            {
+                const auto assignment = arguments[++i];
+                settings.parameterValues.set(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+                                             assignment.fromFirstOccurrenceOf("=", false, false).trim());
+            }
+            else if (argument == "--state" && hasValue)
+            {
+                settings.stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(arguments[++i]);
+            }
+            else if (argument == "--out" && hasValue)
+            {
+                settings.outputFolder = juce::File::getCurrentWorkingDirectory().getChildFile(arguments[++i]);
+            }
+            else if (argument == "--block" && hasValue)
+            {
+                settings.blockSize = juce::jlimit(1, 65536, arguments[++i].getIntValue());
+            }
+            else if (argument == "--jobs" && hasValue)
+            {
+                settings.numWorkers = juce::jmax(1, arguments[++i].getIntValue());
+            }
+            else if (argument.startsWith("--"))
+            {
+                print("Unknown option " + argument);
+                return false;
+            }
+            else
+            {
+                const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(argument);
+
+                if (file.isDirectory())
+                {
+                    auto childFiles = file.findChildFiles(juce::File::findFiles, false, "*.wav;*.flac;*.aif;*.aiff");
+                    childFiles.sort();
+                    settings.inputFiles.addArray(childFiles);
+                }
+                else if (file.existsAsFile())
+                {
+                    settings.inputFiles.add(file);
+                }
+                else
+                {
+                    print("Cannot find " + argument);
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; //The parameters need a message manager, no window is ever created
+
+    juce::StringArray arguments;
+
+    for (int i = 1; i < argc; ++i)
+        arguments.add(juce::CharPointer_UTF8(argv[i]));
+
+    if (arguments.contains("--list-parameters"))
+    {
+        listParameters();
+        return 0;
+    }
+
+    RenderSettings settings;
+
+    if (! parseArguments(arguments, settings) || settings.inputFiles.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (settings.outputFolder != juce::File() && ! settings.outputFolder.createDirectory())
+    {
+        print("Cannot create the output folder " + settings.outputFolder.getFullPathName());
+        return 1;
+    }
+
+    //Workers (Never more than the number of files)
+    std::atomic<int> nextFile { 0 }, numFailedFiles { 0 };
+    juce::OwnedArray<RenderWorker> workers;
+
+    for (int i = 0; i < juce::jmin(settings.numWorkers, settings.inputFiles.size()); ++i)
+        workers.add(new RenderWorker(i, settings, nextFile, numFailedFiles))->startThread();
+
+    for (auto* worker : workers)
+        worker->waitForThreadToExit(-1);
+
+    return numFailedFiles > 0 ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    This file contains the channel groups shared by the SIMD filters of the plugin.
+
+    The channels of a block are filtered numLanes at a time: the samples of a group of channels are interleaved into a
+    scratch buffer of registers, the kernel filters every lane with each instruction and the result is written back.
+    A group with a single channel (Mono, or the last channel of an odd layout) is filtered in place by the scalar
+    kernel, with the state of lane 0 of its registers. Every group owns statesPerGroup registers of state.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+namespace SIMDChannelGroups
+{
+    static constexpr size_t maximumStatesPerGroup = 8; //Largest state of a filter (4 state variable sections of 2 integrators)
+
+    //Runs kernel(Register* samples, int numSamples, Register* state) on every group of channels and
+    //scalarKernel(SampleType* samples, int numSamples, SampleType* state) on a group with a single channel
+    template <typename SampleType, typename Kernel, typename ScalarKernel>
+    void process(juce::dsp::AudioBlock<SampleType>& block, juce::dsp::SIMDRegister<SampleType>* interleaved,
+                 juce::dsp::SIMDRegister<SampleType>* state, size_t statesPerGroup, Kernel&& kernel, ScalarKernel&& scalarKernel) noexcept
+    {
+        using Register = juce::dsp::SIMDRegister<SampleType>;
+        constexpr size_t numLanes = Register::SIMDNumElements;
+
+        jassert(statesPerGroup <= maximumStatesPerGroup);
+
+        const auto numChannels = (int) block.getNumChannels();
+        const auto numSamples = (int) block.getNumSamples();
+        auto* scratch = reinterpret_cast<SampleType*>(interleaved); //Sample i of lane l is at scratch[i * numLanes + l]
+
+        for (size_t group = 0; group * numLanes < (size_t) numChannels; ++group)
+        {
+            const auto firstChannel = (int) (group * numLanes);
+            const auto numGroupChannels = juce::jmin((int) numLanes, numChannels - firstChannel);
+            auto* groupState = state + group * statesPerGroup;
+
+            if (numGroupChannels == 1) //A single channel is filtered in place without interleaving
+            {
+                std::array<SampleType, maximumStatesPerGroup> scalarState;
+
+                for (size_t i = 0; i < statesPerGroup; ++i)
+                    scalarState[i] = groupState[i].get(0);
+
+                scalarKernel(block.getChannelPointer((size_t) firstChannel), numSamples, scalarState.data());
+
+                for (size_t i = 0; i < statesPerGroup; ++i)
+                    groupState[i].set(0, scalarState[i]);
+
+                continue;
+            }
+
+            //Interleaving the channels of the group (The unused lanes stay at zero)
+            if (numGroupChannels < (int) numLanes)
+                std::fill(interleaved, interleaved + numSamples, Register::expand(0));
+
+            for (int lane = 0; lane < numGroupChannels; ++lane)
+            {
+                const auto* channelData = block.getChannelPointer((size_t) (firstChannel + lane));
+
+                for (int i = 0; i < numSamples; ++i)
+                    scratch[(size_t) i * numLanes + (size_t) lane] = channelData[i];
+            }
+
+            //Filtering every lane at once
+            kernel(interleaved, numSamples, groupState);
+
+            //Writing the result back to the channels
+            for (int lane = 0; lane < numGroupChannels; ++lane)
+            {
+                auto* channelData = block.getChannelPointer((size_t) (firstChannel + lane));
+
+                for (int i = 0; i < numSamples; ++i)
+                    channelData[i] = scratch[(size_t) i * numLanes + (size_t) lane];
+            }
+        }
+    }
+
+    template <typename SampleType>
+    void snapToZero(std::vector<juce::dsp::SIMDRegister<SampleType>>& state) noexcept //Removes denormals from the state
+    {
+        for (auto& reg : state)
+        {
+            for (size_t lane = 0; lane < juce::dsp::SIMDRegister<SampleType>::SIMDNumElements; ++lane)
+            {
+                auto value = reg.get(lane);
+                juce::dsp::util::snapToZero(value);
+                reg.set(lane, value);
+            }
+        }
+    }
+}
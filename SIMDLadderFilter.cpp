@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    This file contains the multi-channel ladder filter of the plugin.
+
+    Every stage is y = G x + beta s, s = 2 y - s, so the output of the last stage is G^4 u + S where S only depends on
+    the state. With the input of the first stage u = x - k y4 this gives u = (x - k S) / (1 + k G^4) for every sample,
+    then the 4 stages run in a row.
+
+  ==============================================================================
+*/
+
+#include "SIMDLadderFilter.h"
+#include "FastMath.h"
+
+//==============================================================================
+namespace
+{
+    template <typename Register>
+    struct Coefficients //Coefficients of the block, as registers or as plain samples
+    {
+        Register G, beta, k, inputGain, outputGain;
+    };
+
+    template <typename Register, typename SampleType>
+    Register broadcast(SampleType value) noexcept //Same value in every lane (Or the value itself for the scalar kernel)
+    {
+        if constexpr (std::is_same_v<Register, SampleType>)
+            return value;
+        else
+            return Register::expand(value);
+    }
+
+    //Filter kernel specialised on the response type and on the ramping at compile time, so the loop over the samples has
+    //no branch inside. When ramping, the coefficients start at c and move by step at every sample.
+    template <typename Register, typename SampleType, juce::dsp::StateVariableTPTFilterType type, bool isRamping>
+    void processKernel(Register* samples, int numSamples, Register* state, const Coefficients<Register>& start, const Coefficients<Register>& step) noexcept
+    {
+        using Type = juce::dsp::StateVariableTPTFilterType;
+
+        auto s1 = state[0], s2 = state[1], s3 = state[2], s4 = state[3]; //Local copies so the state stays in registers during the loop
+        const auto four = broadcast<Register>(SampleType(4)), six = broadcast<Register>(SampleType(6));
+        auto c = start; //Every group of channels starts the ramp from the same coefficients
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if constexpr (isRamping)
+            {
+                c.G = c.G + step.G;
+                c.beta = c.beta + step.beta;
+                c.k = c.k + step.k;
+                c.inputGain = c.inputGain + step.inputGain;
+                c.outputGain = c.outputGain + step.outputGain;
+            }
+
+            const auto S = c.beta * (((s1 * c.G + s2) * c.G + s3) * c.G + s4); //Part of the last stage output that comes from the state
+            const auto u = (samples[i] - c.k * S) * c.inputGain; //Input of the first stage, the feedback solved without a delay
+
+            const auto y1 = c.G * u + c.beta * s1;
+            s1 = y1 + y1 - s1;
+            const auto y2 = c.G * y1 + c.beta * s2;
+            s2 = y2 + y2 - s2;
+            const auto y3 = c.G * y2 + c.beta * s3;
+            s3 = y3 + y3 - s3;
+            const auto y4 = c.G * y3 + c.beta * s4;
+            s4 = y4 + y4 - s4;
+
+            if constexpr (type == Type::lowpass)       samples[i] = y4 * c.outputGain; //G^4
+            else if constexpr (type == Type::bandpass) samples[i] = four * (y2 - (y3 + y3) + y4); //4 G^2 (1 - G)^2
+            else                                       samples[i] = u + y4 + six * y2 - four * (y1 + y3); //(1 - G)^4
+        }
+
+        state[0] = s1;
+        state[1] = s2;
+        state[2] = s3;
+        state[3] = s4;
+    }
+
+    template <typename Register>
+    using KernelFunction = void (*)(Register*, int, Register*, const Coefficients<Register>&, const Coefficients<Register>&) noexcept;
+
+    template <typename Register, typename SampleType, bool isRamping>
+    KernelFunction<Register> getKernel(juce::dsp::StateVariableTPTFilterType type) noexcept
+    {
+        using Type = juce::dsp::StateVariableTPTFilterType;
+
+        switch (type)
+        {
+            case Type::bandpass: return processKernel<Register, SampleType, Type::bandpass, isRamping>;
+            case Type::highpass: return processKernel<Register, SampleType, Type::highpass, isRamping>;
+            case Type::lowpass:
+            default:             return processKernel<Register, SampleType, Type::lowpass, isRamping>;
+        }
+    }
+
+    template <typename Register, typename SampleType>
+    KernelFunction<Register> getKernel(juce::dsp::StateVariableTPTFilterType type, bool isRamping) noexcept //Dispatch from the runtime type and ramping to the compiled kernel
+    {
+        return isRamping ? getKernel<Register, SampleType, true>(type) : getKernel<Register, SampleType, false>(type);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    maximumBlockSize = (int) spec.maximumBlockSize;
+
+    const auto numGroups = (spec.numChannels + numLanes - 1) / numLanes; //Groups of channels that share a register
+    state.assign(numGroups * numStages, Register::expand(0));
+    interleaved.assign((size_t) maximumBlockSize, Register::expand(0)); //One group is processed at a time
+
+    update();
+    reset();
+}
+
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::reset() noexcept
+{
+    std::fill(state.begin(), state.end(), Register::expand(0));
+    hasLastCoefficients = false; //The next block starts at its own coefficients
+}
+
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::setCoefficientRamping(bool shouldRamp) noexcept
+{
+    ramping = shouldRamp;
+}
+
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::setType(Type newType) noexcept
+{
+    if (newType != filterType)
+        hasLastCoefficients = false; //A ramp between two responses would not be one of them
+
+    filterType = newType;
+    update(); //Only the low pass is compensated
+}
+
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::setCutoffFrequency(SampleType newFrequencyHz) noexcept
+{
+    jassert(juce::isPositiveAndBelow(newFrequencyHz, static_cast<SampleType>(sampleRate * 0.5)));
+
+    cutoffFrequency = newFrequencyHz;
+    update();
+}
+
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::setResonance(SampleType newResonance) noexcept
+{
+    jassert(newResonance > static_cast<SampleType>(0));
+
+    resonance = newResonance;
+    update();
+}
+
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+
+    sampleRate = newSampleRate;
+    hasLastCoefficients = false; //The last coefficients were for the other rate
+    update();
+}
+
+template <typename SampleType>
+double SIMDLadderFilter<SampleType>::getFeedback(double resonance) noexcept
+{
+    return juce::jlimit(0.0, 3.6, 4.0 * (1.0 - 1.0 / juce::jmax(1.0, resonance)));
+}
+
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::update() noexcept
+{
+    const auto g = FastMath::tan(juce::MathConstants<double>::pi * cutoffFrequency / sampleRate);
+    const auto feedback = getFeedback((double) resonance);
+    const auto G2 = (g / (1.0 + g)) * (g / (1.0 + g));
+    const auto G4 = G2 * G2; //Cheaper than pow() for the cutoff sweeps of the modulation
+
+    G = static_cast<SampleType>(g / (1.0 + g));
+    beta = static_cast<SampleType>(1.0 / (1.0 + g));
+    k = static_cast<SampleType>(feedback);
+    inputGain = static_cast<SampleType>(1.0 / (1.0 + feedback * G4));
+    outputGain = static_cast<SampleType>(filterType == Type::lowpass ? 1.0 + feedback : 1.0); //Unity gain at DC
+}
+
+//==============================================================================
+template <typename SampleType>
+void SIMDLadderFilter<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+    auto& block = context.getOutputBlock();
+
+    jassert((int) block.getNumSamples() <= maximumBlockSize);
+    jassert((int) block.getNumChannels() <= (int) (state.size() / numStages * numLanes));
+
+    if (context.isBypassed)
+        return;
+
+    //Coefficients at the end of the block. When ramping, the block starts at the ones the last block ended with and
+    //moves towards them by the same step at every sample
+    const Coefficients<SampleType> target { G, beta, k, inputGain, outputGain };
+    const Coefficients<SampleType> last { lastG, lastBeta, lastK, lastInputGain, lastOutputGain };
+    const auto blockSize = (int) block.getNumSamples();
+    const auto isRamping = ramping && hasLastCoefficients && blockSize > 0;
+    const auto stepScale = isRamping ? SampleType(1) / (SampleType) blockSize : SampleType(0);
+
+    const auto scalarCoefficients = isRamping ? last : target;
+    const Coefficients<SampleType> scalarSteps { (G - lastG) * stepScale, (beta - lastBeta) * stepScale, (k - lastK) * stepScale,
+                                                 (inputGain - lastInputGain) * stepScale, (outputGain - lastOutputGain) * stepScale };
+    const Coefficients<Register> coefficients { Register::expand(scalarCoefficients.G), Register::expand(scalarCoefficients.beta), Register::expand(scalarCoefficients.k),
+                                                Register::expand(scalarCoefficients.inputGain), Register::expand(scalarCoefficients.outputGain) };
+    const Coefficients<Register> steps { Register::expand(scalarSteps.G), Register::expand(scalarSteps.beta), Register::expand(scalarSteps.k),
+                                         Register::expand(scalarSteps.inputGain), Register::expand(scalarSteps.outputGain) };
+    const auto kernel = getKernel<Register, SampleType>(filterType, isRamping); //Chosen once for the whole block
+    const auto scalarKernel = getKernel<SampleType, SampleType>(filterType, isRamping);
+
+    SIMDChannelGroups::process(block, interleaved.data(), state.data(), numStages,
+                               [&](Register* samples, int numSamples, Register* groupState) { kernel(samples, numSamples, groupState, coefficients, steps); },
+                               [&](SampleType* samples, int numSamples, SampleType* groupState) { scalarKernel(samples, numSamples, groupState, scalarCoefficients, scalarSteps); });
+
+    lastG = G; //The next block ramps from where this one ended
+    lastBeta = beta;
+    lastK = k;
+    lastInputGain = inputGain;
+    lastOutputGain = outputGain;
+    hasLastCoefficients = true;
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    SIMDChannelGroups::snapToZero(state);
+   #endif
+}
+
+//==============================================================================
+template class SIMDLadderFilter<float>;
+template class SIMDLadderFilter<double>;
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    This file contains the multi-channel ladder filter of the plugin.
+
+    A linear 4 pole ladder (Four one pole TPT stages with a global feedback) solved without a delay in the feedback
+    path, so the cutoff and the resonance stay where they are set up to high frequencies. The low pass is the output
+    of the last stage, the band pass and the high pass are mixes of the stages (24 dB/oct low and high pass, 12 dB/oct
+    on each side for the band pass). The channels run in SIMD lanes like the state variable filter and the kernel is
+    compiled for every response type.
+
+    The resonance is the same 1 to 10 range as the state variable filter, mapped to a feedback of 0 (No peak) to 3.6
+    (Just below self oscillation at 4). The low pass is compensated for the loss of bass when the feedback rises.
+
+    The coefficients can be ramped from block to block like the ones of the state variable filter.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDChannelGroups.h"
+
+//==============================================================================
+template <typename SampleType>
+class SIMDLadderFilter
+{
+public:
+    using Type = juce::dsp::StateVariableTPTFilterType; //Same types as the state variable filter
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Register::SIMDNumElements; //Channels filtered by one register
+    static constexpr size_t numStages = 4;
+
+    //==============================================================================
+    void prepare(const juce::dsp::ProcessSpec& spec); //Allocates the state and the scratch buffer
+    void reset() noexcept; //Clears the state of every channel
+
+    void setType(Type newType) noexcept; //Low Pass, Band Pass or High Pass
+    void setCutoffFrequency(SampleType newFrequencyHz) noexcept; //Frequency
+    void setResonance(SampleType newResonance) noexcept; //Resonance
+    void setSampleRate(double newSampleRate) noexcept; //Changes the rate without reallocating (Used when the oversampling factor changes)
+    void setCoefficientRamping(bool shouldRamp) noexcept; //Ramps the coefficients of every block from the ones the last block ended with (Used by the modulation)
+
+    static double getFeedback(double resonance) noexcept; //Feedback of the ladder for a resonance (Also used by the spectrum analyzer)
+
+    //==============================================================================
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept; //Filters every channel of the block in place
+
+private:
+    void update() noexcept; //Recomputes the coefficients (Called only when the frequency, the resonance or the type changed)
+
+    //==============================================================================
+    Type filterType = Type::lowpass;
+    SampleType cutoffFrequency = SampleType(1000), resonance = SampleType(1);
+    SampleType G = 0, beta = 0; //Gain of a stage for its input and for its state (g / (1 + g) and 1 / (1 + g))
+    SampleType k = 0, inputGain = 0, outputGain = 1; //Feedback, 1 / (1 + k G^4) and the bass compensation of the low pass
+    double sampleRate = 44100.0;
+    SampleType lastG = 0, lastBeta = 0, lastK = 0, lastInputGain = 0, lastOutputGain = 1; //Coefficients the last block ended with
+    bool ramping = false, hasLastCoefficients = false;
+
+    std::vector<Register> state; //State of the 4 stages, numStages registers for every group of numLanes channels
+    std::vector<Register> interleaved; //Scratch buffer, the samples of one group of channels side by side
+    int maximumBlockSize = 0;
+};
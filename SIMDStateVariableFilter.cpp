@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+    This file contains the multi-channel state variable filter of the plugin.
+
+    The equations are the ones of juce::dsp::StateVariableTPTFilter, so the output of one section is the same as the
+    JUCE filter within float rounding.
+
+  ==============================================================================
+*/
+
+#include "SIMDStateVariableFilter.h"
+#include "FastMath.h"
+
+//==============================================================================
+namespace
+{
+    template <typename Register>
+    struct Coefficients //Coefficients of every section, as registers or as plain samples
+    {
+        Register g;
+        std::array<Register, SIMDStateVariableFilter<float>::maximumNumSections> h, gPlusR2; //Same for every sample type
+    };
+
+    //Filter kernel specialised on the response type, on the number of sections and on the ramping at compile time, so
+    //the loop over the samples has no branch inside and only computes the outputs it needs. Every sample goes through
+    //all the sections before the next one is read. When ramping, the coefficients start at c and move by step at every
+    //sample. process() chooses the kernel once per block.
+    template <typename Register, juce::dsp::StateVariableTPTFilterType type, int numSections, bool isRamping>
+    void processKernel(Register* samples, int numSamples, Register* state, const Coefficients<Register>& c, const Coefficients<Register>& step) noexcept
+    {
+        using Type = juce::dsp::StateVariableTPTFilterType;
+
+        std::array<Register, numSections * 2> s; //Local copies so the state stays in registers during the loop
+        auto current = c; //Every group of channels starts the ramp from the same coefficients
+
+        for (size_t i = 0; i < s.size(); ++i)
+            s[i] = state[i];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = samples[i];
+
+            if constexpr (isRamping)
+            {
+                current.g = current.g + step.g;
+
+                for (size_t n = 0; n < (size_t) numSections; ++n)
+                {
+                    current.h[n] = current.h[n] + step.h[n];
+                    current.gPlusR2[n] = current.gPlusR2[n] + step.gPlusR2[n];
+                }
+            }
+
+            for (size_t n = 0; n < (size_t) numSections; ++n) //Unrolled, the number of sections is known at compile time
+            {
+                auto& state1 = s[n * 2];
+                auto& state2 = s[n * 2 + 1];
+
+                const auto yHP = current.h[n] * (x - state1 * current.gPlusR2[n] - state2);
+                const auto yBP = yHP * current.g + state1;
+                state1 = yHP * current.g + yBP;
+                const auto yLP = yBP * current.g + state2;
+                state2 = yBP * current.g + yLP;
+
+                if constexpr (type == Type::lowpass)       x = yLP;
+                else if constexpr (type == Type::bandpass) x = yBP;
+                else                                       x = yHP;
+            }
+
+            samples[i] = x;
+        }
+
+        for (size_t i = 0; i < s.size(); ++i)
+            state[i] = s[i];
+    }
+
+    template <typename Register>
+    using KernelFunction = void (*)(Register*, int, Register*, const Coefficients<Register>&, const Coefficients<Register>&) noexcept;
+
+    template <typename Register, juce::dsp::StateVariableTPTFilterType type, bool isRamping>
+    KernelFunction<Register> getKernel(int numSections) noexcept
+    {
+        switch (numSections)
+        {
+            case 2:  return processKernel<Register, type, 2, isRamping>;
+            case 3:  return processKernel<Register, type, 3, isRamping>;
+            case 4:  return processKernel<Register, type, 4, isRamping>;
+            case 1:
+            default: return processKernel<Register, type, 1, isRamping>;
+        }
+    }
+
+    template <typename Register, bool isRamping>
+    KernelFunction<Register> getKernel(juce::dsp::StateVariableTPTFilterType type, int numSections) noexcept
+    {
+        using Type = juce::dsp::StateVariableTPTFilterType;
+
+        switch (type)
+        {
+            case Type::bandpass: return getKernel<Register, Type::bandpass, isRamping>(numSections);
+            case Type::highpass: return getKernel<Register, Type::highpass, isRamping>(numSections);
+            case Type::lowpass:
+            default:             return getKernel<Register, Type::lowpass, isRamping>(numSections);
+        }
+    }
+
+    template <typename Register>
+    KernelFunction<Register> getKernel(juce::dsp::StateVariableTPTFilterType type, int numSections, bool isRamping) noexcept //Dispatch from the runtime type, slope and ramping to the compiled kernel
+    {
+        return isRamping ? getKernel<Register, true>(type, numSections) : getKernel<Register, false>(type, numSections);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    maximumBlockSize = (int) spec.maximumBlockSize;
+
+    const auto numGroups = (spec.numChannels + numLanes - 1) / numLanes; //Groups of channels that share a register
+    state.assign(numGroups * maximumNumSections * 2, Register::expand(0));
+    interleaved.assign((size_t) maximumBlockSize, Register::expand(0)); //One group is processed at a time
+
+    updateResonance();
+    reset();
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::reset() noexcept
+{
+    std::fill(state.begin(), state.end(), Register::expand(0));
+    hasLastCoefficients = false; //The next block starts at its own coefficients
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::setCoefficientRamping(bool shouldRamp) noexcept
+{
+    ramping = shouldRamp;
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::setType(Type newType) noexcept
+{
+    if (newType != filterType)
+        hasLastCoefficients = false; //A ramp between two responses would not be one of them
+
+    filterType = newType;
+    updateResonance(); //The Q of the sections depends on the type
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::setCutoffFrequency(SampleType newFrequencyHz) noexcept
+{
+    jassert(juce::isPositiveAndBelow(newFrequencyHz, static_cast<SampleType>(sampleRate * 0.5)));
+
+    cutoffFrequency = newFrequencyHz;
+    updateCutoff(); //The Q of the sections does not change
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::setResonance(SampleType newResonance) noexcept
+{
+    jassert(newResonance > static_cast<SampleType>(0));
+
+    resonance = newResonance;
+    updateResonance();
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::setNumSections(int newNumSections) noexcept
+{
+    jassert(newNumSections >= 1 && newNumSections <= maximumNumSections);
+
+    newNumSections = juce::jlimit(1, maximumNumSections, newNumSections);
+
+    //The sections that were not running still hold the state they had when the slope was lower, so they start again from silence
+    for (size_t group = 0; group < state.size(); group += maximumNumSections * 2)
+        std::fill(state.begin() + (std::ptrdiff_t) (group + (size_t) numSections * 2),
+                  state.begin() + (std::ptrdiff_t) (group + maximumNumSections * 2), Register::expand(0));
+
+    if (newNumSections != numSections)
+        hasLastCoefficients = false;
+
+    numSections = newNumSections;
+    updateResonance();
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+
+    sampleRate = newSampleRate;
+    hasLastCoefficients = false; //The last coefficients were for the other rate
+    updateCutoff();
+}
+
+template <typename SampleType>
+double SIMDStateVariableFilter<SampleType>::getSectionResonance(int section, int numSections, double resonance, Type type) noexcept
+{
+    if (type == Type::bandpass) //Band pass sections keep their peak at the cutoff, so they all get the resonance
+        return resonance;
+
+    //Q of the section in a Butterworth filter of order 2 * numSections (The sections are sorted by rising Q)
+    const auto butterworthQ = [numSections](int k) { return 1.0 / (2.0 * std::cos((2 * k + 1) * juce::MathConstants<double>::pi / (4.0 * numSections))); };
+
+    if (section < numSections - 1)
+        return butterworthQ(section);
+
+    //The last section adds the resonance above its Butterworth Q, so a resonance of 1 is a flat response for the cascades
+    //and a single section keeps the Q it always had
+    return resonance - 1.0 + juce::jmax(1.0, butterworthQ(section));
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::updateResonance() noexcept
+{
+    for (int n = 0; n < numSections; ++n)
+        R2[(size_t) n] = static_cast<SampleType>(1.0 / getSectionResonance(n, numSections, (double) resonance, filterType));
+
+    updateCutoff();
+}
+
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::updateCutoff() noexcept
+{
+    g = FastMath::tan(static_cast<SampleType>(juce::MathConstants<double>::pi * cutoffFrequency / sampleRate)); //Once per chunk when the cutoff is modulated
+
+    for (int n = 0; n < numSections; ++n)
+        h[(size_t) n] = static_cast<SampleType>(1.0 / (1.0 + R2[(size_t) n] * g + g * g));
+}
+
+//==============================================================================
+template <typename SampleType>
+void SIMDStateVariableFilter<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+    auto& block = context.getOutputBlock();
+
+    jassert((int) block.getNumSamples() <= maximumBlockSize);
+    jassert((int) block.getNumChannels() <= (int) (state.size() / (maximumNumSections * 2) * numLanes));
+
+    if (context.isBypassed)
+        return;
+
+    //Coefficients at the end of the block. When ramping, the block starts at the ones the last block ended with and
+    //moves towards them by the same step at every sample
+    const auto blockSize = (int) block.getNumSamples();
+    const auto isRamping = ramping && hasLastCoefficients && blockSize > 0;
+    const auto stepScale = isRamping ? SampleType(1) / (SampleType) blockSize : SampleType(0);
+
+    Coefficients<SampleType> scalarCoefficients, scalarSteps;
+    scalarCoefficients.g = isRamping ? lastG : g;
+    scalarSteps.g = (g - lastG) * stepScale;
+
+    for (size_t n = 0; n < (size_t) numSections; ++n)
+    {
+        scalarCoefficients.h[n] = isRamping ? lastH[n] : h[n];
+        scalarCoefficients.gPlusR2[n] = isRamping ? lastGPlusR2[n] : g + R2[n];
+        scalarSteps.h[n] = (h[n] - lastH[n]) * stepScale;
+        scalarSteps.gPlusR2[n] = (g + R2[n] - lastGPlusR2[n]) * stepScale;
+    }
+
+    //Same coefficients as registers for the groups of channels
+    Coefficients<Register> coefficients, steps;
+    coefficients.g = Register::expand(scalarCoefficients.g);
+    steps.g = Register::expand(scalarSteps.g);
+
+    for (size_t n = 0; n < (size_t) numSections; ++n)
+    {
+        coefficients.h[n] = Register::expand(scalarCoefficients.h[n]);
+        coefficients.gPlusR2[n] = Register::expand(scalarCoefficients.gPlusR2[n]);
+        steps.h[n] = Register::expand(scalarSteps.h[n]);
+        steps.gPlusR2[n] = Register::expand(scalarSteps.gPlusR2[n]);
+    }
+
+    const auto kernel = getKernel<Register>(filterType, numSections, isRamping); //Chosen once for the whole block
+    const auto scalarKernel = getKernel<SampleType>(filterType, numSections, isRamping);
+
+    SIMDChannelGroups::process(block, interleaved.data(), state.data(), maximumNumSections * 2,
+                               [&](Register* samples, int numSamples, Register* groupState) { kernel(samples, numSamples, groupState, coefficients, steps); },
+                               [&](SampleType* samples, int numSamples, SampleType* groupState) { scalarKernel(samples, numSamples, groupState, scalarCoefficients, scalarSteps); });
+
+    //The next block ramps from where this one ended
+    lastG = g;
+
+    for (size_t n = 0; n < (size_t) numSections; ++n)
+    {
+        lastH[n] = h[n];
+        lastGPlusR2[n] = g + R2[n];
+    }
+
+    hasLastCoefficients = true;
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    SIMDChannelGroups::snapToZero(state);
+   #endif
+}
+
+//==============================================================================
+template class SIMDStateVariableFilter<float>;
+template class SIMDStateVariableFilter<double>;
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    This file contains the multi-channel state variable filter of the plugin.
+
+    It is the same TPT filter as juce::dsp::StateVariableTPTFilter, but the state of every channel is kept in one lane
+    of a juce::dsp::SIMDRegister, so 4 (SSE/NEON) or 8 (AVX) channels are filtered with every instruction. The block is
+    interleaved into a scratch buffer that is allocated in prepare(), so processing never allocates.
+
+    Up to 4 sections can be cascaded for slopes of 12 to 48 dB/oct. The sections run one after the other inside the
+    same loop over the samples, so a steep slope reads and writes the block once instead of once per section. Low and
+    high pass sections get the Q of a Butterworth filter of the whole order and the resonance goes to the last one.
+
+    The loop over the samples is compiled once for every response type and number of sections, so it has no branch
+    inside and they are only looked at once per block.
+
+    With the coefficient ramping on, every block moves the coefficients in a straight line from the ones the last
+    block ended with to the current ones, one step per sample. The modulation of the engine sets a new cutoff every
+    few samples, so a sweep is smooth while tan() only runs once for every step of the modulation. Changing the type,
+    the slope or the rate, or a reset, jumps to the new coefficients instead.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDChannelGroups.h"
+
+//==============================================================================
+template <typename SampleType>
+class SIMDStateVariableFilter
+{
+public:
+    using Type = juce::dsp::StateVariableTPTFilterType; //Same types as the JUCE filter
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Register::SIMDNumElements; //Channels filtered by one register
+    static constexpr int maximumNumSections = 4; //48 dB/oct
+
+    //==============================================================================
+    void prepare(const juce::dsp::ProcessSpec& spec); //Allocates the state and the scratch buffer
+    void reset() noexcept; //Clears the state of every channel
+
+    void setType(Type newType) noexcept; //Low Pass, Band Pass or High Pass
+    void setCutoffFrequency(SampleType newFrequencyHz) noexcept; //Frequency
+    void setResonance(SampleType newResonance) noexcept; //Resonance (Q of the last section)
+    void setNumSections(int newNumSections) noexcept; //Slope (12 dB/oct per section, the new sections start from silence)
+    void setSampleRate(double newSampleRate) noexcept; //Changes the rate without reallocating (Used when the oversampling factor changes)
+    void setCoefficientRamping(bool shouldRamp) noexcept; //Ramps the coefficients of every block from the ones the last block ended with (Used by the modulation)
+
+    static double getSectionResonance(int section, int numSections, double resonance, Type type) noexcept; //Q of one section of the cascade (Also used by the spectrum analyzer)
+
+    //==============================================================================
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept; //Filters every channel of the block in place
+
+private:
+    void updateResonance() noexcept; //Recomputes the Q of the sections and the coefficients (Called only when the resonance, the type or the slope changed)
+    void updateCutoff() noexcept; //Recomputes the coefficients that depend on the frequency (The only ones a cutoff sweep changes)
+
+    //==============================================================================
+    Type filterType = Type::lowpass;
+    SampleType cutoffFrequency = SampleType(1000), resonance = SampleType(1.0 / juce::MathConstants<double>::sqrt2);
+    int numSections = 1;
+    SampleType g = 0; //Coefficients (Same names as the JUCE filter, every section has the same cutoff)
+    std::array<SampleType, maximumNumSections> h {}, R2 {};
+    double sampleRate = 44100.0;
+    SampleType lastG = 0; //Coefficients the last block ended with (g + R2 is what the kernel reads)
+    std::array<SampleType, maximumNumSections> lastH {}, lastGPlusR2 {};
+    bool ramping = false, hasLastCoefficients = false;
+
+    std::vector<Register> state; //Integrators of every section, maximumNumSections * 2 registers for every group of numLanes channels
+    std::vector<Register> interleaved; //Scratch buffer, the samples of one group of channels side by side
+    int maximumBlockSize = 0;
+};
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    This file contains the sliding window RMS detector shared by the compressors of the plugin.
+
+    The mean square of the last windowSamples squares is kept as a running sum: every sample adds its square and
+    removes the one that leaves the window, so a sample costs the same for any length of the window. The squares are
+    kept in a ring buffer that is allocated in prepare() for the longest window, so changing the window never
+    allocates. Adding and removing the same values does not cancel exactly in floating point, so the sums are added up
+    again from the ring buffer once every window (One more addition per sample on average), which keeps the rounding
+    errors of a loud passage from staying in the level of the quiet one after it.
+
+    The values are either samples (One detector for every channel) or SIMD registers (One detector for every group of
+    channels). Every detector moves forward by the same number of samples in each block.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+template <typename ValueType>
+class SlidingWindowRms
+{
+public:
+    //==============================================================================
+    void prepare(size_t newNumDetectors, int maximumWindowSamples) //Allocates the ring buffer of every detector
+    {
+        jassert(maximumWindowSamples > 0);
+
+        numDetectors = newNumDetectors;
+        maximumWindow = maximumWindowSamples;
+        bufferSize = juce::nextPowerOfTwo(maximumWindow);
+        bufferMask = bufferSize - 1;
+        buffer.assign(numDetectors * (size_t) bufferSize, ValueType {});
+        sums.assign(numDetectors, ValueType {});
+        setWindow(juce::jmin(window, maximumWindow));
+        reset();
+    }
+
+    void reset() noexcept //Clears the squares and the sums
+    {
+        std::fill(buffer.begin(), buffer.end(), ValueType {});
+        std::fill(sums.begin(), sums.end(), ValueType {});
+        writePosition = 0;
+        samplesSinceRefresh = 0;
+    }
+
+    void setWindow(int newWindowSamples) noexcept //Length of the window in samples (1 to the maximum given to prepare), the sums are added up again for it
+    {
+        window = juce::jlimit(1, juce::jmax(1, maximumWindow), newWindowSamples);
+        windowInverse = fromScalar(1.0 / (double) window);
+        refresh();
+    }
+
+    int getWindow() const noexcept { return window; }
+
+    //==============================================================================
+    //Mean square over the window at every sample of one detector (meanSquares can be the samples themselves)
+    void process(size_t detector, const ValueType* samples, ValueType* meanSquares, int numSamples) noexcept
+    {
+        jassert(detector < numDetectors);
+
+        auto* squares = buffer.data() + detector * (size_t) bufferSize;
+        auto sum = sums[detector];
+        auto position = writePosition;
+        const auto zero = ValueType {};
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto square = samples[i] * samples[i];
+            sum += square - squares[(position - window) & bufferMask]; //Read before the write, the buffer can be exactly one window long
+            squares[position] = square;
+            position = (position + 1) & bufferMask;
+
+            if constexpr (std::is_floating_point_v<ValueType>)
+                meanSquares[i] = juce::jmax(sum, zero) * windowInverse; //The rounding can leave the sum slightly under zero when the window goes silent
+            else
+                meanSquares[i] = ValueType::max(sum, zero) * windowInverse;
+        }
+
+        sums[detector] = sum;
+    }
+
+    void advance(int numSamples) noexcept //Moves every detector forward once their samples of the block went through process()
+    {
+        writePosition = (writePosition + numSamples) & bufferMask;
+        samplesSinceRefresh += numSamples;
+
+        if (samplesSinceRefresh >= window)
+            refresh();
+    }
+
+private:
+    static ValueType fromScalar(double value) noexcept
+    {
+        if constexpr (std::is_floating_point_v<ValueType>)
+            return static_cast<ValueType>(value);
+        else
+            return ValueType::expand(static_cast<typename ValueType::ElementType>(value));
+    }
+
+    void refresh() noexcept //Adds up the squares of the window again for every detector
+    {
+        for (size_t detector = 0; detector < numDetectors; ++detector)
+        {
+            const auto* squares = buffer.data() + detector * (size_t) bufferSize;
+            auto sum = ValueType {};
+
+            for (int i = 1; i <= window; ++i)
+                sum += squares[(writePosition - i) & bufferMask];
+
+            sums[detector] = sum;
+        }
+
+        samplesSinceRefresh = 0;
+    }
+
+    //==============================================================================
+    std::vector<ValueType> buffer; //Squares of every detector, next to each other (Each one is bufferSize values long)
+    std::vector<ValueType> sums; //Running sum of the window of every detector
+    size_t numDetectors = 0;
+    int maximumWindow = 1, window = 1, bufferSize = 0, bufferMask = 0; //The size is a power of two so the positions wrap with a mask
+    int writePosition = 0, samplesSinceRefresh = 0;
+    ValueType windowInverse {};
+};
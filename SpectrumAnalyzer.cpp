@@ -0,0 +1,259 @@
+/*
+  ==============================================================================
+
+    This file contains the spectrum analyzer of the filter mode, with the magnitude response of the filter over it.
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+#include "PluginParameters.h"
+#include "SIMDStateVariableFilter.h"
+#include "SIMDLadderFilter.h"
+
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer(AnalyzerFifo& fifoToUse, juce::AudioProcessorValueTreeState& parameters, const juce::AudioProcessor& processorToUse)
+    : fifo(fifoToUse), processor(processorToUse)
+{
+    filterFrequency = parameters.getRawParameterValue(ParameterIDs::filterFrequency);
+    filterResonance = parameters.getRawParameterValue(ParameterIDs::filterResonance);
+    filterType = parameters.getRawParameterValue(ParameterIDs::filterType);
+    filterOversampling = parameters.getRawParameterValue(ParameterIDs::filterOversampling);
+    filterSlope = parameters.getRawParameterValue(ParameterIDs::filterSlope);
+    filterTopology = parameters.getRawParameterValue(ParameterIDs::filterTopology);
+
+    levels.fill(spectrumFloordB);
+    setInterceptsMouseClicks(false, false); //The analyzer only displays
+    setOpaque(true); //paint() fills every pixel
+    lastUpdateTime = juce::Time::getMillisecondCounterHiRes() * 0.001;
+}
+
+//==============================================================================
+void SpectrumAnalyzer::update()
+{
+    const auto now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    const auto elapsedSeconds = (float) juce::jlimit(0.0, 0.1, now - lastUpdateTime);
+    lastUpdateTime = now;
+
+    if (! isShowing()) //Only the filter mode shows the analyzer, the processor does not send samples in the other modes
+        return;
+
+    //Copying the new samples into the history
+    const auto numNewSamples = fifo.pop([this](const float* samples, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            history[(size_t) historyPosition] = samples[i];
+            historyPosition = (historyPosition + 1) & (fftSize - 1);
+        }
+    });
+
+    auto needsRepaint = false;
+
+    //Spectrum (Nothing to do when no sample arrived and every level is already at the floor)
+    const auto isFalling = std::any_of(levels.begin(), levels.end(), [](float level) { return level > spectrumFloordB; });
+
+    if (numNewSamples > 0 || isFalling)
+    {
+        computeSpectrum(elapsedSeconds);
+        buildSpectrumPath();
+        needsRepaint = true;
+    }
+
+    //Response (Only rebuilt when the filter changed)
+    if (filterHasChanged())
+    {
+        buildResponsePath();
+        needsRepaint = true;
+    }
+
+    if (needsRepaint)
+        repaint();
+}
+
+void SpectrumAnalyzer::computeSpectrum(float elapsedSeconds)
+{
+    //Oldest sample first, so the window is centred on the last fftSize samples
+    const auto numFirst = fftSize - historyPosition;
+    std::copy(history.begin() + historyPosition, history.end(), fftData.begin());
+    std::copy(history.begin(), history.begin() + historyPosition, fftData.begin() + numFirst);
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    //Levels in dB (A full scale sine reads 0 dB: the Hann window halves the amplitude and the FFT sums fftSize / 2 of each side)
+    const auto normalisation = 4.0f / (float) fftSize;
+    const auto fall = fallRatedB * elapsedSeconds;
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const auto leveldB = juce::Decibels::gainToDecibels(fftData[(size_t) bin] * normalisation, spectrumFloordB);
+        levels[(size_t) bin] = juce::jmax(leveldB, levels[(size_t) bin] - fall, spectrumFloordB); //Rises at once, falls at a fixed rate
+    }
+}
+
+//==============================================================================
+float SpectrumAnalyzer::frequencyToX(float frequency) const noexcept
+{
+    return (float) getWidth() * std::log(frequency / minimumFrequency) / std::log(maximumFrequency / minimumFrequency);
+}
+
+float SpectrumAnalyzer::xToFrequency(float x) const noexcept
+{
+    return minimumFrequency * std::pow(maximumFrequency / minimumFrequency, x / (float) juce::jmax(1, getWidth()));
+}
+
+double SpectrumAnalyzer::getSampleRate() const noexcept
+{
+    const auto sampleRate = processor.getSampleRate();
+    return sampleRate > 0.0 ? sampleRate : 44100.0;
+}
+
+void SpectrumAnalyzer::buildSpectrumPath()
+{
+    //One point every 2 pixels, the level between two bins is interpolated (Several bins per point are merged at the top of the axis)
+    const auto width = (float) getWidth(), height = (float) getHeight();
+    const auto binsPerHz = (float) fftSize / (float) getSampleRate();
+
+    spectrumPath.clear();
+    spectrumPath.startNewSubPath(0.0f, height);
+
+    for (float x = 0.0f; x <= width; x += 2.0f)
+    {
+        const auto position = juce::jlimit(0.0f, (float) (numBins - 1), xToFrequency(x) * binsPerHz);
+        const auto lowerBin = juce::jmin((int) position, numBins - 2);
+        const auto nextPosition = juce::jlimit(0.0f, (float) (numBins - 1), xToFrequency(x + 2.0f) * binsPerHz);
+
+        auto leveldB = juce::jmap(position - (float) lowerBin, levels[(size_t) lowerBin], levels[(size_t) lowerBin + 1]);
+
+        for (auto bin = lowerBin + 2; (float) bin < nextPosition; ++bin) //Peak of the bins that fall between two points
+            leveldB = juce::jmax(leveldB, levels[(size_t) bin]);
+
+        spectrumPath.lineTo(x, juce::jmap(leveldB, spectrumFloordB, 0.0f, height, 0.0f));
+    }
+
+    spectrumPath.lineTo(width, height);
+    spectrumPath.closeSubPath();
+}
+
+bool SpectrumAnalyzer::filterHasChanged() noexcept
+{
+    const auto frequency = filterFrequency->load(std::memory_order_relaxed);
+    const auto resonance = filterResonance->load(std::memory_order_relaxed);
+    const auto type = (int) filterType->load(std::memory_order_relaxed);
+    const auto oversampling = (int) filterOversampling->load(std::memory_order_relaxed);
+    const auto slope = (int) filterSlope->load(std::memory_order_relaxed);
+    const auto topology = (int) filterTopology->load(std::memory_order_relaxed);
+    const auto sampleRate = getSampleRate();
+
+    if (frequency == lastFrequency && resonance == lastResonance && type == lastType
+        && oversampling == lastOversampling && slope == lastSlope && topology == lastTopology && sampleRate == lastSampleRate)
+        return false;
+
+    lastFrequency = frequency;
+    lastResonance = resonance;
+    lastType = type;
+    lastOversampling = oversampling;
+    lastSlope = slope;
+    lastTopology = topology;
+    lastSampleRate = sampleRate;
+    return true;
+}
+
+void SpectrumAnalyzer::buildResponsePath()
+{
+    //Magnitude of the TPT filters: the analog prototype at the prewarped frequency tan(pi f / fs) / tan(pi fc / fs)
+    //(The filter runs at the oversampled rate, so the rate is the one of the oversampling)
+    using Type = juce::dsp::StateVariableTPTFilterType;
+    const auto width = (float) getWidth(), height = (float) getHeight();
+    const auto filterRate = lastSampleRate * (double) (1 << juce::jmax(0, lastOversampling));
+    const auto g = std::tan(juce::MathConstants<double>::pi * juce::jmin((double) lastFrequency, filterRate * 0.499) / filterRate);
+    const auto type = lastType == FilterTypes::bandPass ? Type::bandpass : lastType == FilterTypes::highPass ? Type::highpass : Type::lowpass;
+    const auto resonance = (double) juce::jmax(lastResonance, 0.01f);
+    const auto numSections = juce::jlimit(1, SIMDStateVariableFilter<float>::maximumNumSections, lastSlope + 1);
+    const auto k = SIMDLadderFilter<float>::getFeedback(resonance);
+
+    responsePath.clear();
+
+    for (float x = 0.0f; x <= width; x += 2.0f)
+    {
+        const auto frequency = juce::jmin((double) xToFrequency(x), filterRate * 0.499);
+        const auto w = std::tan(juce::MathConstants<double>::pi * frequency / filterRate) / g; //Normalised analog frequency
+        double magnitude = 1.0;
+
+        if (lastTopology == FilterTopologies::ladder) //4 one pole stages G = 1 / (1 + s) with the feedback k around them
+        {
+            const auto G = 1.0 / std::complex<double>(1.0, w);
+            const auto G4 = G * G * G * G;
+            auto response = G4 * (1.0 + k); //Low Pass (With the bass compensation)
+
+            if (type == Type::bandpass)
+                response = 4.0 * G * G * (1.0 - G) * (1.0 - G);
+            else if (type == Type::highpass)
+                response = (1.0 - G) * (1.0 - G) * (1.0 - G) * (1.0 - G);
+
+            magnitude = std::abs(response / (1.0 + k * G4));
+        }
+        else //Product of the sections of the cascade
+        {
+            for (int section = 0; section < numSections; ++section)
+            {
+                const auto R2 = 1.0 / SIMDStateVariableFilter<float>::getSectionResonance(section, numSections, resonance, type);
+                const auto denominator = std::sqrt((1.0 - w * w) * (1.0 - w * w) + (w * R2) * (w * R2));
+
+                if (type == Type::bandpass)
+                    magnitude *= w / denominator;
+                else if (type == Type::highpass)
+                    magnitude *= w * w / denominator;
+                else
+                    magnitude /= denominator; //Low Pass
+            }
+        }
+
+        const auto magnitudedB = juce::jlimit(responseMinimumdB, responseMaximumdB, juce::Decibels::gainToDecibels((float) magnitude, responseMinimumdB));
+        const auto y = juce::jmap(magnitudedB, responseMinimumdB, responseMaximumdB, height, 0.0f);
+
+        if (x == 0.0f)
+            responsePath.startNewSubPath(x, y);
+        else
+            responsePath.lineTo(x, y);
+    }
+}
+
+void SpectrumAnalyzer::buildGridPath()
+{
+    const auto height = (float) getHeight();
+    gridPath.clear();
+
+    for (auto frequency : { 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f }) //Frequency lines
+    {
+        const auto x = frequencyToX(frequency);
+        gridPath.addLineSegment({ x, 0.0f, x, height }, 1.0f);
+    }
+
+    const auto y = juce::jmap(0.0f, responseMinimumdB, responseMaximumdB, height, 0.0f); //0 dB of the response
+    gridPath.addLineSegment({ 0.0f, y, (float) getWidth(), y }, 1.0f);
+}
+
+//==============================================================================
+void SpectrumAnalyzer::resized()
+{
+    buildGridPath();
+    buildSpectrumPath();
+    buildResponsePath();
+}
+
+void SpectrumAnalyzer::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colour(0xff111111)); //Backround
+
+    g.setColour(juce::Colour(0x23ffffff)); //Grid
+    g.fillPath(gridPath);
+
+    g.setColour(juce::Colour(0x804B0082)); //Spectrum
+    g.fillPath(spectrumPath);
+
+    g.setColour(juce::Colour(0xffff88ff)); //Filter Response
+    g.strokePath(responsePath, juce::PathStrokeType(2.0f));
+}
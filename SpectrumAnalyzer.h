@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    This file contains the spectrum analyzer of the filter mode, with the magnitude response of the filter over it.
+
+    The output of the plugin comes from the AnalyzerFifo of the processor. On every vblank the analyzer reads the new
+    samples into a history, runs one windowed FFT of the last fftSize samples and smooths the levels of the bins, all
+    on the message thread. The spectrum and the response are cached as paths: the spectrum path is rebuilt only when
+    new samples arrived (Or while the levels are still falling) and the response path only when the frequency, the
+    resonance, the type or the oversampling of the filter changed, so paint() only fills and strokes them.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyzerFifo.h"
+
+//==============================================================================
+class SpectrumAnalyzer  : public juce::Component
+{
+public:
+    SpectrumAnalyzer(AnalyzerFifo& fifoToUse, juce::AudioProcessorValueTreeState& parameters, const juce::AudioProcessor& processorToUse);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void update(); //Reads the new samples, runs the FFT and rebuilds the paths that changed (Called on every vblank)
+    void computeSpectrum(float elapsedSeconds); //FFT of the history and smoothing of the levels
+    void buildSpectrumPath();
+    void buildResponsePath();
+    void buildGridPath();
+    bool filterHasChanged() noexcept; //Compares the filter parameters with the ones the response path was built with
+
+    float frequencyToX(float frequency) const noexcept; //Logarithmic frequency axis
+    float xToFrequency(float x) const noexcept;
+    double getSampleRate() const noexcept; //Rate of the processor (44.1 kHz before it is prepared)
+
+    static constexpr int fftOrder = 11; //2048 points (About 23 Hz per bin at 48 kHz)
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = fftSize / 2 + 1;
+    static constexpr float minimumFrequency = 20.0f, maximumFrequency = 20000.0f; //Frequency axis
+    static constexpr float spectrumFloordB = -96.0f; //Bottom of the spectrum (The top is 0 dB)
+    static constexpr float responseMinimumdB = -48.0f, responseMaximumdB = 24.0f; //Range of the response curve
+    static constexpr float fallRatedB = 48.0f; //dB per second the levels fall at once the signal drops
+
+    AnalyzerFifo& fifo;
+    const juce::AudioProcessor& processor;
+    std::atomic<float>* filterFrequency = nullptr; //Atomic values of the filter parameters
+    std::atomic<float>* filterResonance = nullptr;
+    std::atomic<float>* filterType = nullptr;
+    std::atomic<float>* filterOversampling = nullptr;
+    std::atomic<float>* filterSlope = nullptr;
+    std::atomic<float>* filterTopology = nullptr;
+
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann };
+    std::array<float, fftSize> history {}; //Last fftSize samples of the output (Circular)
+    int historyPosition = 0;
+    std::array<float, fftSize * 2> fftData {}; //Work buffer of the FFT (Twice the size for the frequency only transform)
+    std::array<float, numBins> levels {}; //Smoothed level of every bin, in dB
+
+    juce::Path spectrumPath, responsePath, gridPath; //Cached between frames
+    float lastFrequency = 0.0f, lastResonance = 0.0f; //Filter values the response path was built with
+    int lastType = -1, lastOversampling = -1, lastSlope = -1, lastTopology = -1;
+    double lastSampleRate = 0.0;
+    double lastUpdateTime = 0.0; //Time of the last vblank, in seconds
+
+    juce::VBlankAttachment vBlankAttachment { this, [this] { update(); } }; //Declared last so it is detached before the buffers are deleted
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};